@@ -34,6 +34,19 @@
     CALL_ALERT_SECS: 10 * 60,
     CHAT_ALERT_SECS: 10 * 60,
     CALL_CLEAR_TICKS: 3,
+    ROW_FULL_RESCAN_MS: 30_000,
+    SAVE_FLUSH_TIMEOUT: 2000,
+    HISTORY_MAX_EVENTS: 200,      // par agent et par jour
+    HISTORY_RETENTION_DAYS: 90,   // résumés dailyAgg conservés
+    LEADER_HEARTBEAT_MS: 1000,
+    LEADER_TIMEOUT_MS: 3500,      // sans heartbeat → un autre onglet prend la main
+    LEADER_ELECT_MS: 400,         // attente d'un leader existant au démarrage
+    LEADER_HIDDEN_TIMEOUT_MS: 70_000, // leader masqué : timers bridés (~1/min) par le navigateur
+    HOVER_RETRY_MS: 3000,         // mini-card absente → nouveau survol
+    HOVER_STALE_MS: 30_000,       // mini-card présente → rafraîchie au-delà
+    HOVER_BUDGET_MS: 8,           // par frame d'inactivité
+    HOVER_BATCH: 16,              // rects lus en bloc avant dispatch
+    HOVER_IDLE_TIMEOUT: 1000,
 
     PANEL_MIN_W: 480,
     PANEL_MIN_H: 560,
@@ -88,8 +101,9 @@
   let chatOffStreak        = Storage.get('chatOffStreak', {});
   let muted                = Storage.get('muted', false);
   let snoozeUntil          = Storage.get('snoozeUntil', 0);
-  let historyByDay         = Storage.get('historyByDay', {});
-  let dailyAgg             = Storage.get('dailyAgg', {});
+  let historyByDay         = {}; // chargé depuis IndexedDB (HistoryStore.load)
+  let dailyAgg             = {};
+  let historyOpenDay       = Storage.get('historyOpenDay', null); // jour dont le détail est encore ouvert
   let lastProhibSubtype    = Storage.get('lastProhibSubtype', {});
 
   let favorites            = new Set(Storage.get('favorites', []));
@@ -101,34 +115,356 @@
   let sortCallsOrder       = Storage.get('sortCallsOrder', 'desc');
   let sortStatusOrder      = Storage.get('sortStatusOrder', '');
 
-  const save = () => {
-    Storage.set('masterSlotList', masterSlotList);
-    Storage.set('connectedUsers', connectedUsers);
-    Storage.set('lastGroup', lastGroup);
-    Storage.set('slotCounter', slotCounter);
-    Storage.set('lastStatusKey', lastStatusKey);
-    Storage.set('statusStartAt', statusStartAt);
-    Storage.set('callStartAt', callStartAt);
-    Storage.set('chatStartAt', chatStartAt);
-    Storage.set('lastInCall', lastInCall);
-    Storage.set('callOffStreak', callOffStreak);
-    Storage.set('lastInChat', lastInChat);
-    Storage.set('chatOffStreak', chatOffStreak);
-    Storage.set('favorites', [...favorites]);
-    Storage.set('sectionVisibility', sectionVisibility);
-    Storage.set('searchFilter', searchFilter);
-    Storage.set('minimized', minimized);
-    Storage.set('panelPos', panelPos);
-    Storage.set('panelSize', panelSize);
-    Storage.set('sortCallsOrder', sortCallsOrder);
-    Storage.set('sortStatusOrder', sortStatusOrder);
-    Storage.set('muted', muted);
-    Storage.set('snoozeUntil', snoozeUntil);
-    Storage.set('historyByDay', historyByDay);
-    Storage.set('dailyAgg', dailyAgg);
-    Storage.set('lastProhibSubtype', lastProhibSubtype);
+  // Clé persistée → valeur courante, lue au moment du flush
+  const PERSISTED = {
+    masterSlotList:    () => masterSlotList,
+    connectedUsers:    () => connectedUsers,
+    lastGroup:         () => lastGroup,
+    slotCounter:       () => slotCounter,
+    lastStatusKey:     () => lastStatusKey,
+    statusStartAt:     () => statusStartAt,
+    callStartAt:       () => callStartAt,
+    chatStartAt:       () => chatStartAt,
+    lastInCall:        () => lastInCall,
+    callOffStreak:     () => callOffStreak,
+    lastInChat:        () => lastInChat,
+    chatOffStreak:     () => chatOffStreak,
+    favorites:         () => [...favorites],
+    sectionVisibility: () => sectionVisibility,
+    searchFilter:      () => searchFilter,
+    minimized:         () => minimized,
+    panelPos:          () => panelPos,
+    panelSize:         () => panelSize,
+    sortCallsOrder:    () => sortCallsOrder,
+    sortStatusOrder:   () => sortStatusOrder,
+    muted:             () => muted,
+    snoozeUntil:       () => snoozeUntil,
+    lastProhibSubtype: () => lastProhibSubtype,
+    historyOpenDay:    () => historyOpenDay,
+    // historyByDay / dailyAgg : écrits par HistoryStore (IndexedDB)
+    historyByDay:      null,
+    dailyAgg:          null
   };
 
+  // Relecture depuis localStorage (onglet qui devient leader : l'ancien a flushé au pagehide)
+  const PERSISTED_SET = {
+    masterSlotList:    v => { masterSlotList = v || []; },
+    connectedUsers:    v => { connectedUsers = v || []; },
+    lastGroup:         v => { lastGroup = v || {}; },
+    slotCounter:       v => { slotCounter = v || 1; },
+    lastStatusKey:     v => { lastStatusKey = v || {}; },
+    statusStartAt:     v => { statusStartAt = v || {}; },
+    callStartAt:       v => { callStartAt = v || {}; },
+    chatStartAt:       v => { chatStartAt = v || {}; },
+    lastInCall:        v => { lastInCall = v || {}; },
+    callOffStreak:     v => { callOffStreak = v || {}; },
+    lastInChat:        v => { lastInChat = v || {}; },
+    chatOffStreak:     v => { chatOffStreak = v || {}; },
+    favorites:         v => { favorites = new Set(v || []); },
+    sectionVisibility: v => { if (v) sectionVisibility = v; },
+    searchFilter:      v => { searchFilter = v || ''; },
+    minimized:         v => { minimized = !!v; },
+    panelPos:          v => { panelPos = v || null; },
+    panelSize:         v => { panelSize = v || null; },
+    sortCallsOrder:    v => { sortCallsOrder = v == null ? 'desc' : v; },
+    sortStatusOrder:   v => { sortStatusOrder = v || ''; },
+    muted:             v => { muted = !!v; },
+    snoozeUntil:       v => { snoozeUntil = v || 0; },
+    lastProhibSubtype: v => { lastProhibSubtype = v || {}; },
+    historyOpenDay:    v => { historyOpenDay = v || null; }
+  };
+
+  // except : clés à garder telles quelles (préférences locales d'un onglet promu)
+  const reloadPersisted = (except = []) => {
+    Object.keys(PERSISTED_SET)
+      .filter(k => !except.includes(k))
+      .forEach(k => PERSISTED_SET[k](Storage.get(k, null)));
+  };
+
+  // Préférences partagées qu'un onglet suiveur transmet au leader (seul à écrire) ;
+  // le leader les renvoie dans chaque diffusion 'state'
+  const PREF_KEYS = [
+    'favorites', 'sectionVisibility', 'sortCallsOrder', 'sortStatusOrder', 'muted', 'snoozeUntil'
+  ];
+  // Collections : transmises en deltas (setPref), jamais en entier, sinon la copie
+  // d'un onglet écraserait les ajouts faits ailleurs entre-temps
+  const PREF_DELTA_KEYS = ['favorites', 'sectionVisibility'];
+  // Préférences propres à l'onglet (disposition, recherche) : jamais transmises,
+  // un suiveur les écrit lui-même (même flush différé que le leader)
+  const LOCAL_PREF_KEYS = ['searchFilter', 'minimized', 'panelPos', 'panelSize'];
+
+  let dirtyKeys = new Set();
+  let flushPending = false;
+  let persistFrozen = false; // reset complet en cours → plus aucune écriture
+  let isLeaderTab = false;   // seul l'onglet leader écrit (voir TabLeader)
+
+  // Marque les clés modifiées (toutes si aucune n'est précisée).
+  // L'écriture est groupée en un seul flush, au prochain moment d'inactivité.
+  // Onglet suiveur : les préférences partagées partent au leader, seules ses
+  // préférences locales sont marquées.
+  const save = (...keys) => {
+    if (!isLeaderTab) {
+      const list = keys.length ? keys : PREF_KEYS.concat(LOCAL_PREF_KEYS);
+      TabLeader.forwardPrefs(list
+        .filter(k => PREF_KEYS.includes(k) && !PREF_DELTA_KEYS.includes(k))
+        .map(k => ({ key: k, value: PERSISTED[k]() })));
+      keys = list.filter(k => LOCAL_PREF_KEYS.includes(k));
+      if (!keys.length) return;
+    }
+    (keys.length ? keys : Object.keys(PERSISTED)).forEach(k => dirtyKeys.add(k));
+    if (flushPending) return;
+    flushPending = true;
+    if (window.requestIdleCallback) {
+      requestIdleCallback(flush, { timeout: CONFIG.SAVE_FLUSH_TIMEOUT });
+    } else {
+      setTimeout(flush, CONFIG.SAVE_FLUSH_TIMEOUT);
+    }
+  };
+
+  // Applique une modification de préférence partagée → clé touchée (null si inconnue)
+  // { fav, on } | { section, visible } | { key, value } (valeur scalaire)
+  const applyPrefOp = op => {
+    if (op.fav != null) {
+      if (op.on) favorites.add(op.fav);
+      else favorites.delete(op.fav);
+      return 'favorites';
+    }
+    if (op.section != null) {
+      sectionVisibility[op.section] = !!op.visible;
+      return 'sectionVisibility';
+    }
+    if (PREF_KEYS.includes(op.key) && !PREF_DELTA_KEYS.includes(op.key)) {
+      PERSISTED_SET[op.key](op.value);
+      return op.key;
+    }
+    return null;
+  };
+
+  // Modification locale d'une préférence partagée : persistée par le leader,
+  // transmise en delta par un suiveur
+  const setPref = op => {
+    const key = applyPrefOp(op);
+    if (!key) return;
+    if (isLeaderTab) save(key);
+    else TabLeader.forwardPrefs([op]);
+  };
+
+  function flush() {
+    flushPending = false;
+    if (persistFrozen || !dirtyKeys.size) return;
+    let keys = dirtyKeys;
+    dirtyKeys = new Set();
+    // Suiveur : uniquement ses préférences locales, le reste appartient au leader
+    if (!isLeaderTab) keys = [...keys].filter(k => LOCAL_PREF_KEYS.includes(k));
+    let history = false;
+    keys.forEach(k => {
+      if (PERSISTED[k]) Storage.set(k, PERSISTED[k]());
+      else history = true;
+    });
+    if (history && !HistoryStore.flush()) {
+      // Historique pas encore chargé : on le garde pour le flush suivant
+      dirtyKeys.add('historyByDay');
+    }
+  }
+
+  window.addEventListener('pagehide', flush);
+  document.addEventListener('visibilitychange', () => {
+    if (document.hidden) flush();
+  });
+
+  // ===================== HISTORIQUE (IndexedDB, un enregistrement par jour) =====================
+  // Enregistrement { day, history, agg }. Seul le jour courant est chargé au démarrage ;
+  // un jour clôturé ne garde que ses résumés (history vidé), purgés après HISTORY_RETENTION_DAYS.
+  const HISTORY_DB = CONFIG.STORAGE_PREFIX + 'history';
+  const HISTORY_STORE = 'days';
+
+  let historyDb = null;        // Promise<IDBDatabase>
+  let historyDbHandle = null;  // IDBDatabase une fois ouverte : put synchrone au pagehide
+  let historyReady = false;    // jour courant chargé (sinon un flush écraserait la base)
+  let historyUseIdb = true;    // false → repli localStorage
+  let historyDirtyDays = new Set();
+
+  const idbReq = req => new Promise((resolve, reject) => {
+    req.onsuccess = () => resolve(req.result);
+    req.onerror = () => reject(req.error);
+  });
+  const idbDone = tx => new Promise((resolve, reject) => {
+    tx.oncomplete = resolve;
+    tx.onerror = () => reject(tx.error);
+  });
+  const dayKeyDaysAgo = n => new Date(Date.now() - n * 24 * 60 * 60 * 1000).toISOString().slice(0, 10);
+
+  class HistoryStore {
+    static db() {
+      if (!historyDb) {
+        const req = indexedDB.open(HISTORY_DB, 1);
+        req.onupgradeneeded = () => {
+          req.result.createObjectStore(HISTORY_STORE, { keyPath: 'day' });
+        };
+        historyDb = idbReq(req).then(db => {
+          historyDbHandle = db;
+          db.onclose = () => { historyDbHandle = null; historyDb = null; };
+          return db;
+        });
+      }
+      return historyDb;
+    }
+
+    static async load() {
+      const today = todayKey();
+      const cutoff = dayKeyDaysAgo(CONFIG.HISTORY_RETENTION_DAYS);
+      // Lu AVANT tout await : un processAgents pendant l'ouverture de la base passe par
+      // histRollover, qui avance historyOpenDay à aujourd'hui sans pouvoir compacter
+      const openDay = historyOpenDay;
+      try {
+        if (!window.indexedDB) throw new Error('IndexedDB indisponible');
+        const db = await this.db();
+        await this.migrateFromLocalStorage(db, today);
+
+        const tx = db.transaction(HISTORY_STORE, 'readwrite');
+        const store = tx.objectStore(HISTORY_STORE);
+        // Jour resté ouvert (onglet fermé avant minuit) → on ne garde que ses résumés
+        if (openDay && openDay < today) {
+          const open = await idbReq(store.get(openDay));
+          if (open) store.put({ day: open.day, history: {}, agg: open.agg || {} });
+        }
+        store.delete(IDBKeyRange.upperBound(cutoff, true));
+        const rec = await idbReq(store.get(today));
+        await idbDone(tx);
+        if (rec) this.mergeDay(rec);
+      } catch (e) {
+        log.warn('Historique IndexedDB indisponible, repli localStorage', e);
+        historyUseIdb = false;
+        const lsHist = Storage.get('historyByDay', {}) || {};
+        const lsAgg = Storage.get('dailyAgg', {}) || {};
+        new Set([...Object.keys(lsHist), ...Object.keys(lsAgg)]).forEach(day => {
+          if (day < cutoff) return;
+          this.mergeDay({ day, history: day === today ? lsHist[day] : {}, agg: lsAgg[day] });
+        });
+      }
+      historyOpenDay = today;
+      historyReady = true;
+      historyDirtyDays.add(today);
+      save('historyByDay', 'historyOpenDay');
+    }
+
+    // Anciennes versions : tout l'historique en objets dans 2 clés localStorage
+    static async migrateFromLocalStorage(db, today) {
+      const oldHist = Storage.get('historyByDay', null);
+      const oldAgg = Storage.get('dailyAgg', null);
+      if (!oldHist && !oldAgg) return;
+      const days = new Set([...Object.keys(oldHist || {}), ...Object.keys(oldAgg || {})]);
+      const tx = db.transaction(HISTORY_STORE, 'readwrite');
+      const store = tx.objectStore(HISTORY_STORE);
+      days.forEach(day => {
+        const hist = (oldHist && oldHist[day]) || {};
+        const agg = (oldAgg && oldAgg[day]) || {};
+        // Les compteurs n'existaient pas : on les reconstitue depuis les évènements
+        Object.keys(hist).forEach(name => {
+          const a = agg[name] || (agg[name] = { callMs: 0, chatMs: 0, postcallMs: 0, ronaMs: 0 });
+          (hist[name] || []).forEach(ev => {
+            const c = HIST_COUNTERS[ev.type];
+            if (c) a[c] = (a[c] || 0) + 1;
+          });
+          hist[name] = histRecord(hist[name]);
+        });
+        store.put({ day, history: day === today ? hist : {}, agg });
+      });
+      await idbDone(tx);
+      localStorage.removeItem(CONFIG.STORAGE_PREFIX + 'historyByDay');
+      localStorage.removeItem(CONFIG.STORAGE_PREFIX + 'dailyAgg');
+      log.info('Historique migré vers IndexedDB: ' + days.size + ' jour(s)');
+    }
+
+    // Fusionne un jour stocké avec ce qui a été enregistré en mémoire avant le chargement
+    static mergeDay(rec) {
+      const day = rec.day;
+      const memHist = historyByDay[day] || {};
+      const hist = {};
+      Object.keys(rec.history || {}).forEach(name => {
+        hist[name] = histRecord(rec.history[name]);
+      });
+      Object.keys(memHist).forEach(name => {
+        const r = hist[name] || (hist[name] = histNewRecord());
+        histDecode(memHist[name]).forEach(ev => histPush(r, ev.ts, ev.type, ev.durMs, histArg(ev)));
+      });
+      historyByDay[day] = hist;
+
+      const memAgg = dailyAgg[day] || {};
+      const agg = rec.agg || {};
+      Object.keys(memAgg).forEach(name => {
+        const a = agg[name] || (agg[name] = {});
+        Object.keys(memAgg[name]).forEach(f => { a[f] = (a[f] || 0) + memAgg[name][f]; });
+      });
+      dailyAgg[day] = agg;
+    }
+
+    static touch(day) {
+      historyDirtyDays.add(day);
+    }
+
+    // Nouvel onglet leader : l'historique en mémoire peut dater, on repart de la base
+    static reload() {
+      historyByDay = {};
+      dailyAgg = {};
+      historyReady = false;
+      historyDirtyDays = new Set();
+      return this.load();
+    }
+
+    // Écrit les jours modifiés. Retourne false tant que le jour courant n'est pas chargé.
+    static flush() {
+      if (!historyReady) return false;
+      const days = [...historyDirtyDays];
+      historyDirtyDays = new Set();
+      if (!days.length) return true;
+
+      if (!historyUseIdb) {
+        Storage.set('historyByDay', historyByDay);
+        Storage.set('dailyAgg', dailyAgg);
+        return true;
+      }
+      // Base déjà ouverte : transaction émise dans la même tâche (le pagehide ne laisse
+      // pas le temps à un .then) ; sinon on attend l'ouverture
+      if (historyDbHandle) {
+        try {
+          this.writeDays(historyDbHandle, days);
+        } catch (e) {
+          // Base fermée entre-temps : les jours seront réécrits au prochain flush
+          days.forEach(day => historyDirtyDays.add(day));
+          historyDbHandle = null;
+          historyDb = null;
+          log.error('Historique put', e);
+        }
+      } else {
+        this.db().then(db => this.writeDays(db, days)).catch(e => log.error('Historique put', e));
+      }
+      return true;
+    }
+
+    static writeDays(db, days) {
+      const store = db.transaction(HISTORY_STORE, 'readwrite').objectStore(HISTORY_STORE);
+      days.forEach(day => store.put({
+        day,
+        history: historyByDay[day] || {},
+        agg: dailyAgg[day] || {}
+      }));
+      // Jour clôturé et écrit : inutile de le garder en mémoire
+      days.filter(day => day !== historyOpenDay).forEach(day => {
+        delete historyByDay[day];
+        delete dailyAgg[day];
+      });
+    }
+
+    static clear() {
+      historyDirtyDays = new Set();
+      if (!historyUseIdb || !window.indexedDB) return Promise.resolve();
+      return this.db()
+        .then(db => idbReq(db.transaction(HISTORY_STORE, 'readwrite').objectStore(HISTORY_STORE).clear()))
+        .catch(e => log.error('Historique clear', e));
+    }
+  }
+
   // ===================== HELPERS =====================
   const txt        = el => (el && (el.innerText || el.textContent) || '').trim();
   const nowIso     = () => new Date().toISOString();
@@ -139,6 +475,11 @@
     '&':'&amp;','<':'&lt;','>':'&gt;','"':'&quot;','\'':'&#39;'
   }[m]));
   const norm       = s => (s || '').normalize('NFD').replace(/[\u0300-\u036f]/g, '').toLowerCase();
+
+  // Sélecteurs comptés (remis à zéro à chaque processAgents, visible dans debug())
+  let selectorCalls = 0;
+  const qs  = (scope, sel) => { selectorCalls++; return scope.querySelector(sel); };
+  const qsa = (scope, sel) => { selectorCalls++; return scope.querySelectorAll(sel); };
   const toHMS      = ms => {
     const total = Math.floor(ms / 1000);
     const h = Math.floor(total / 3600);
@@ -203,7 +544,108 @@
     '[class*="work-item"]'
   ];
 
-  // ===================== STATUTS (depuis rapport) =====================
+  // ===================== STATUTS : CLASSIFIEUR COMPILÉ =====================
+  // Tables FR/EN compilées une fois en regex. Seuls quelques dizaines de libellés distincts
+  // existent : chaque (texte brut, classes du rond) est classé une fois puis mémoïsé.
+  // → { statusClass, key (section imposée par le texte, sinon null), prohibSub, rona, postcall,
+  //     interaction, available }
+  const anyOf = words => new RegExp(words.map(w => w.replace(/[.*+?^${}()|[\]\\]/g, '\\$&')).join('|'));
+
+  // Texte qui domine les classes du rond
+  const DOT_TEXT_RULES = [
+    { cls: 'On Call',  re: /\b(interaction|interacting|on\s*call|en\s*appel|en\s*conversation)\b/ },
+    { cls: 'On Queue', re: /\b(file d'attente|en\s*file|on\s*queue)\b/ }
+  ];
+
+  // Classes du rond de présence
+  const DOT_CLASS_RULES = [
+    { cls: 'On Call',   re: anyOf(['busy', 'interacting', 'on_call']) },
+    { cls: 'On Queue',  re: anyOf(['on_queue']) },
+    { cls: 'Available', re: anyOf(['available']) },
+    { cls: 'Away',      re: anyOf(['away']) },
+    { cls: 'Offline',   re: anyOf(['offline']) }
+  ];
+
+  // Repli : classes de l'élément OU texte, dans l'ordre
+  const ELEMENT_RULES = [
+    { cls: 'On Call',         classes: anyOf(['interacting']),         text: anyOf(['interaction']) },
+    { cls: 'Busy',            classes: anyOf(['busy']),                text: anyOf(['occupé']) },
+    { cls: 'Meal',            classes: anyOf(['meal']),                text: anyOf(['repas']) },
+    { cls: 'Break',           classes: anyOf(['break']),               text: anyOf(['pause']) },
+    { cls: 'Meeting',         classes: anyOf(['meeting']),             text: anyOf(['réunion']) },
+    { cls: 'Training',        classes: anyOf(['training']),            text: anyOf(['formation']) },
+    { cls: 'Available',       classes: anyOf(['available']),           text: anyOf(['disponible']) },
+    { cls: 'Away',            classes: anyOf(['away']),                text: anyOf(['absent']) },
+    { cls: 'On Queue',        classes: anyOf(['on_queue', 'on-queue']), text: anyOf(['file d\'attente', 'en file', 'queue']) },
+    { cls: 'On Call',         classes: anyOf(['on_call', 'on-call']),  text: anyOf(['en appel']) },
+    { cls: 'Offline',         classes: anyOf(['offline']),             text: anyOf(['hors ligne', 'déconnecté']) },
+    { cls: 'Associated Task', classes: null,                           text: anyOf(['tâche associée', 'associated task']) }
+  ];
+
+  // Statuts prohibés (texte sans accents)
+  const RONA_RE     = anyOf(['sans reponse', 'rona', 'no answer', 'ring no answer', 'not answered']);
+  const POSTCALL_RE = anyOf(['travail apres appel', 'postcall', 'after call work', 'acw', 'wrap']);
+
+  // Sections imposées par le texte, par priorité ; st = minuscules, n = sans accents
+  const STATUS_KEY_RULES = [
+    { key: 'prohib',          n: new RegExp(RONA_RE.source + '|' + POSTCALL_RE.source) },
+    { key: 'tache',           st: anyOf(['tâche', 'tache', 'work item', 'workitem', 'associated task']),
+                              n: anyOf(['tache associee']) },
+    { key: 'non_telecontact', st: anyOf(['non télé', 'non-télé']),
+                              n: anyOf(['non telecontact', 'non-telecontact', 'non tele contact', 'non telec']) },
+    { key: 'pause',           st: anyOf(['pause', 'break']) },
+    { key: 'repas',           st: anyOf(['repas', 'meal']) },
+    { key: 'reunion',         st: anyOf(['réunion', 'reunion', 'meeting']) },
+    { key: 'formation',       st: anyOf(['formation', 'training']) },
+    { key: 'travaux',         st: anyOf(['travaux pay']) }
+  ];
+
+  const STATUS_MEMO_MAX = 512; // garde-fou si un libellé embarque une valeur variable
+  const statusMemo = new Map();
+  let classifierStats = { hits: 0, misses: 0 };
+
+  function statusClassFromElementRules(classes, t) {
+    const rule = ELEMENT_RULES.find(r => (classes && r.classes && r.classes.test(classes)) || r.text.test(t));
+    return rule ? rule.cls : 'default';
+  }
+
+  // dotClass : className du rond de présence, ou null sans rond
+  function classifyStatus(raw, dotClass) {
+    const text = raw || '';
+    const classes = dotClass == null ? null : String(dotClass).toLowerCase();
+    const memoKey = (classes == null ? '\u0000' : classes) + '\u0001' + text;
+    const hit = statusMemo.get(memoKey);
+    if (hit) {
+      classifierStats.hits++;
+      return hit;
+    }
+    classifierStats.misses++;
+
+    const st = text.trim().toLowerCase();
+    const n = norm(text);
+
+    let statusClass = (DOT_TEXT_RULES.find(r => r.re.test(st)) || {}).cls;
+    if (!statusClass && classes != null) statusClass = (DOT_CLASS_RULES.find(r => r.re.test(classes)) || {}).cls;
+    if (!statusClass) statusClass = statusClassFromElementRules('', st);
+
+    const keyRule = STATUS_KEY_RULES.find(r => (r.st && r.st.test(st)) || (r.n && r.n.test(n)));
+    const rona = RONA_RE.test(n);
+    const postcall = POSTCALL_RE.test(n);
+    const res = Object.freeze({
+      statusClass,
+      key: keyRule ? keyRule.key : null,
+      prohibSub: rona ? 'RONA' : (postcall ? 'Postcall' : ''),
+      rona,
+      postcall,
+      interaction: st.includes('interaction'),
+      available: st.includes('available') || st.includes('disponible')
+    });
+
+    if (statusMemo.size >= STATUS_MEMO_MAX) statusMemo.clear();
+    statusMemo.set(memoKey, res);
+    return res;
+  }
+
   function getStatusClassFromElement(statusElement, explicitText) {
     const text = (explicitText || (statusElement ? statusElement.textContent : '') || '')
       .trim()
@@ -211,104 +653,68 @@
     const classes = (statusElement && statusElement.className
       ? String(statusElement.className).toLowerCase()
       : '');
-
-    if (classes.includes('interacting') || text.includes('interaction')) return 'On Call';
-    if (classes.includes('busy') || text.includes('occupé')) return 'Busy';
-    if (classes.includes('meal') || text.includes('repas')) return 'Meal';
-    if (classes.includes('break') || text.includes('pause')) return 'Break';
-    if (classes.includes('meeting') || text.includes('réunion')) return 'Meeting';
-    if (classes.includes('training') || text.includes('formation')) return 'Training';
-    if (classes.includes('available') || text.includes('disponible')) return 'Available';
-    if (classes.includes('away') || text.includes('absent')) return 'Away';
-    if (classes.includes('on_queue') || classes.includes('on-queue') ||
-        text.includes('file d\'attente') || text.includes('en file') || text.includes('queue'))
-      return 'On Queue';
-    if (classes.includes('on_call') || classes.includes('on-call') || text.includes('en appel'))
-      return 'On Call';
-    if (classes.includes('offline') || text.includes('hors ligne') || text.includes('déconnecté'))
-      return 'Offline';
-    if (text.includes('tâche associée') || text.includes('associated task'))
-      return 'Associated Task';
-
-    return 'default';
+    return statusClassFromElementRules(classes, text);
   }
 
   function getStatusClassFromDot(dot, explicitText) {
-  const t = (explicitText || '').toLowerCase();
-
-  // 0) Le texte domine (cas "En interaction" sans classe interacting)
-  if (/\b(interaction|interacting|on\s*call|en\s*appel|en\s*conversation)\b/.test(t)) return 'On Call';
-  if (/\b(file d'attente|en\s*file|on\s*queue)\b/.test(t)) return 'On Queue';
-
-  // 1) Sinon, on regarde les classes du rond
-  if (!dot) return getStatusClassFromElement(null, explicitText);
-  const classes = String(dot.className).toLowerCase();
-
-  if (classes.includes('busy') || classes.includes('interacting') || classes.includes('on_call')) return 'On Call';
-  if (classes.includes('on_queue')) return 'On Queue';
-  if (classes.includes('available')) return 'Available';
-  if (classes.includes('away')) return 'Away';
-  if (classes.includes('offline')) return 'Offline';
-
-  // 2) Fallback : heuristique texte
-  return getStatusClassFromElement(null, explicitText);
-}
-
-
+    return classifyStatus(explicitText, dot ? dot.className : null).statusClass;
+  }
 
   // ===================== STATUTS PROHIBÉS =====================
   function isRonaStatus(s) {
-    const n = norm(s);
-    return n.includes('sans reponse') ||
-           n.includes('rona') ||
-           n.includes('no answer') ||
-           n.includes('ring no answer') ||
-           n.includes('not answered');
+    return classifyStatus(s).rona;
   }
 
   function isPostcallStatus(s) {
-    const n = norm(s);
-    return n.includes('travail apres appel') ||
-           n.includes('postcall') ||
-           n.includes('after call work') ||
-           n.includes('acw') ||
-           n.includes('wrap');
+    return classifyStatus(s).postcall;
   }
 
   function prohibSubtypeFromStatus(s) {
-    if (isRonaStatus(s)) return 'RONA';
-    if (isPostcallStatus(s)) return 'Postcall';
-    return '';
+    return classifyStatus(s).prohibSub;
   }
 
   // ===================== ACTIVITÉ VIA MINI-CARDS (rapport) =====================
-  // Utilise la mécanique de ton dernier script : on ne lit que les mini-cards/indicateurs du rapport
-  function getActivityCountFromMiniCard(name) {
-    let maxCount = 0;
+  // Utilise la mécanique de ton dernier script : on ne lit que les mini-cards/indicateurs du rapport.
+  // Index nom → nb d'activités construit en une passe, invalidé par le MutationObserver.
+  const MINI_CARD_SELECTOR = '.entity-v3-mini-card';
+  let miniCardIndex = null; // null = à reconstruire
+
+  function buildMiniCardIndex() {
+    const index = new Map();
     getAllDocs().forEach(doc => {
-      const cards = doc.querySelectorAll('.entity-v3-mini-card.visible, .entity-v3-mini-card');
-      cards.forEach(card => {
-        const nameEl = card.querySelector('.name-header, .name');
+      qsa(doc, MINI_CARD_SELECTOR).forEach(card => {
+        const nameEl = qs(card, '.name-header, .name');
         if (!nameEl) return;
         const cardName = (nameEl.textContent || '').trim();
-        if (cardName !== name) return;
-
-        const indicator = card.querySelector('.entity-v3-activity-indicator');
-        if (!indicator) return;
-
-        const text = (indicator.textContent || '').trim();
-        if (indicator.classList.contains('has-activity')) {
-          const m = text.match(/(\d+)/);
-          if (m) {
-            const val = parseInt(m[1], 10);
-            if (!isNaN(val) && val > maxCount) maxCount = val;
-          } else if (maxCount === 0) {
-            maxCount = 1;
-          }
-        }
+        if (!cardName) return;
+        if (!index.has(cardName)) index.set(cardName, 0); // carte présente, sans activité
+
+        const indicator = qs(card, '.entity-v3-activity-indicator');
+        if (!indicator || !indicator.classList.contains('has-activity')) return;
+
+        const m = (indicator.textContent || '').trim().match(/(\d+)/);
+        const val = m ? parseInt(m[1], 10) : 1;
+        if (!isNaN(val) && val > (index.get(cardName) || 0)) index.set(cardName, val);
       });
     });
-    return maxCount;
+    return index;
+  }
+
+  function invalidateMiniCards() {
+    miniCardIndex = null;
+  }
+
+  function getActivityCountFromMiniCard(name) {
+    if (!miniCardIndex) {
+      miniCardIndex = buildMiniCardIndex();
+      scanStats.miniCardBuilds++;
+    }
+    return miniCardIndex.get(name) || 0;
+  }
+
+  function hasMiniCard(name) {
+    getActivityCountFromMiniCard(name);
+    return miniCardIndex.has(name);
   }
 
   // ===================== SECTIONS (v1 conservées) =====================
@@ -357,36 +763,132 @@
 // ========= PARTIE 3 / 5 =========
 // Détection via le rapport, slots, timers, deriveStatusKey, call/chat state
 
-// ===================== HISTORIQUE (basé sur v1) =====================
+// ===================== HISTORIQUE (compact, borné) =====================
+// Un agent / un jour = colonnes parallèles bornées à HISTORY_MAX_EVENTS :
+//   t0 (epoch ms du 1er évènement), ts (offset en s depuis t0), ty (code type),
+//   du (durée en s), ar (code argument : section cible ou sous-type prohibé).
+// À la clôture du jour, seuls les résumés dailyAgg sont conservés.
+
+const HIST_TYPES = ['status', 'call_end', 'chat_end', 'prohib_on', 'prohib_off'];
+const HIST_ARGS  = ['', 'RONA', 'Postcall'].concat(SECTION_DEFS.map(s => s.key));
+const HIST_COUNTERS = { status: 'statusChanges', call_end: 'calls', chat_end: 'chats', prohib_on: 'prohibs' };
+const HIST_COLUMNS = ['ts', 'ty', 'du', 'ar'];
+
+const histNewRecord = () => ({ t0: 0, ts: [], ty: [], du: [], ar: [] });
+const histCode = (table, v) => { const i = table.indexOf(v); return i >= 0 ? i : v; };
+const histArg = ev => (ev.to != null ? ev.to : (ev.sub || ''));
+
+// Nombre d'évènements poussés par enregistrement : distingue deux états même une fois
+// le plafond atteint (longueur constante). Sert de clé aux infobulles mises en cache.
+const histVersions = new WeakMap();
+const histPreviewCache = new Map(); // name → { rec, ver, text }
+
+function histPush(rec, ts, type, durMs, arg) {
+  if (!rec.ts.length) rec.t0 = ts;
+  rec.ts.push(Math.round((ts - rec.t0) / 1000));
+  rec.ty.push(histCode(HIST_TYPES, type));
+  rec.du.push(durMs ? Math.round(durMs / 1000) : 0);
+  rec.ar.push(histCode(HIST_ARGS, arg || ''));
+  const over = rec.ts.length - CONFIG.HISTORY_MAX_EVENTS;
+  if (over > 0) HIST_COLUMNS.forEach(c => rec[c].splice(0, over));
+  histVersions.set(rec, (histVersions.get(rec) || 0) + 1);
+}
+
+// Ancien format (tableau d'objets) → colonnes
+function histRecord(raw) {
+  if (!Array.isArray(raw)) return raw || histNewRecord();
+  const rec = histNewRecord();
+  raw.forEach(ev => histPush(rec, ev.ts, ev.type, ev.durMs, histArg(ev)));
+  return rec;
+}
+
+// Colonnes → évènements { ts, type, durMs, to | sub }, à partir de l'index `from`
+function histDecode(rec, from = 0) {
+  const out = [];
+  for (let i = Math.max(0, from); i < rec.ts.length; i++) {
+    const type = typeof rec.ty[i] === 'number' ? HIST_TYPES[rec.ty[i]] : rec.ty[i];
+    const arg = typeof rec.ar[i] === 'number' ? HIST_ARGS[rec.ar[i]] : rec.ar[i];
+    const ev = { ts: rec.t0 + rec.ts[i] * 1000, type, durMs: rec.du[i] * 1000 };
+    if (type === 'status') ev.to = arg;
+    else ev.sub = arg;
+    out.push(ev);
+  }
+  return out;
+}
+
+function aggEntry(day, name) {
+  if (!dailyAgg[day]) dailyAgg[day] = {};
+  if (!dailyAgg[day][name]) {
+    dailyAgg[day][name] = {
+      callMs: 0, chatMs: 0, postcallMs: 0, ronaMs: 0,
+      calls: 0, chats: 0, prohibs: 0, statusChanges: 0
+    };
+  }
+  return dailyAgg[day][name];
+}
+
+// Changement de jour en cours de session : le jour précédent est clôturé
+function histRollover() {
+  const day = todayKey();
+  if (historyOpenDay !== day) {
+    if (historyOpenDay && historyByDay[historyOpenDay]) {
+      historyByDay[historyOpenDay] = {};
+      HistoryStore.touch(historyOpenDay);
+    }
+    historyOpenDay = day;
+    save('historyOpenDay');
+  }
+  return day;
+}
 
 function histAdd(name, type, payload) {
   if (!name) return;
-  const day = todayKey();
+  const day = histRollover();
+  const p = payload || {};
   if (!historyByDay[day]) historyByDay[day] = {};
-  if (!historyByDay[day][name]) historyByDay[day][name] = [];
-  historyByDay[day][name].push(Object.assign({ ts: Date.now(), type }, payload || {}));
-  const arr = historyByDay[day][name];
-  if (arr.length > 200) arr.splice(0, arr.length - 200);
-  save();
+  if (!historyByDay[day][name]) historyByDay[day][name] = histNewRecord();
+  histPush(historyByDay[day][name], Date.now(), type, p.durMs, histArg(p));
+  if (HIST_COUNTERS[type]) aggEntry(day, name)[HIST_COUNTERS[type]]++;
+  HistoryStore.touch(day);
+  save('historyByDay');
 }
 
 function aggAddMs(name, field, ms) {
   if (!name || !field) return;
-  const day = todayKey();
-  if (!dailyAgg[day]) dailyAgg[day] = {};
-  if (!dailyAgg[day][name]) {
-    dailyAgg[day][name] = { callMs: 0, chatMs: 0, postcallMs: 0, ronaMs: 0 };
-  }
+  const day = histRollover();
+  const entry = aggEntry(day, name);
   const capped = clamp(ms, 0, 8 * 60 * 60 * 1000);
-  dailyAgg[day][name][field] =
-    (dailyAgg[day][name][field] || 0) + capped;
-  save();
+  entry[field] = (entry[field] || 0) + capped;
+  HistoryStore.touch(day);
+  save('dailyAgg');
+}
+
+// Derniers évènements d'un agent (jour courant), du plus récent au plus ancien
+function histRecent(name, n) {
+  const day = todayKey();
+  const rec = historyByDay[day] && historyByDay[day][name];
+  if (!rec) return [];
+  return histDecode(rec, rec.ts.length - n).reverse();
+}
+
+// Empreinte bon marché de l'historique du jour d'un agent (signature des cartes) :
+// nombre d'évènements + horodatage du dernier, sans décodage ni formatage
+function histStamp(name) {
+  if (!isLeaderTab) return remotePreviews[name] || '';
+  const day = todayKey();
+  const rec = historyByDay[day] && historyByDay[day][name];
+  if (!rec || !rec.ts.length) return '';
+  return day + ':' + (histVersions.get(rec) || rec.ts.length) + ':' + rec.ts[rec.ts.length - 1];
 }
 
 function histPreview(name) {
+  if (!isLeaderTab && name in remotePreviews) return remotePreviews[name];
   const day = todayKey();
-  const arr = (historyByDay[day] && historyByDay[day][name]) ? historyByDay[day][name] : [];
-  const last = arr.slice(-5).reverse().map(ev => {
+  const rec = historyByDay[day] && historyByDay[day][name];
+  const ver = histVersions.get(rec) || 0;
+  const hit = histPreviewCache.get(name);
+  if (hit && hit.rec === rec && hit.ver === ver) return hit.text;
+  const last = histRecent(name, 5).map(ev => {
     const t = new Date(ev.ts).toLocaleTimeString();
     if (ev.type === 'call_end')   return t + ' • Fin appel (' + toHMS(ev.durMs) + ')';
     if (ev.type === 'chat_end')   return t + ' • Fin chat (' + toHMS(ev.durMs) + ')';
@@ -395,7 +897,9 @@ function histPreview(name) {
     if (ev.type === 'prohib_off') return t + ' • Fin prohibé (' + (ev.sub || '') + ', ' + toHMS(ev.durMs) + ')';
     return t + ' • ' + ev.type;
   }).join('\n');
-  return last || 'Aucun historique';
+  const text = last || 'Aucun historique';
+  histPreviewCache.set(name, { rec, ver, text });
+  return text;
 }
 
 // ===================== SLOTS (version v1 adaptée) =====================
@@ -417,7 +921,7 @@ class SlotManager {
       lastCallAt: null,
       lastSeen: Date.now()
     });
-    save();
+    save('masterSlotList', 'slotCounter');
     return slot;
   }
 
@@ -430,7 +934,7 @@ class SlotManager {
     const [m] = masterSlotList.splice(idx, 1);
     masterSlotList.push(m);
     masterSlotList.forEach((row, i) => { row.slot = i + 1; });
-    save();
+    save('masterSlotList');
   }
 
   static getSlot(name) {
@@ -450,7 +954,7 @@ class SlotManager {
     masterSlotList = masterSlotList.filter(i => !i.lastSeen || i.lastSeen > cutoff);
     if (masterSlotList.length !== before) {
       log.info('Nettoyage slots: ' + (before - masterSlotList.length) + ' supprimé(s)');
-      save();
+      save('masterSlotList');
     }
   }
 }
@@ -464,7 +968,7 @@ class ConnectedUsersManager {
     unique.forEach(n => SlotManager.assignSlot(n));
 
     connectedUsers = unique;
-    save();
+    save('connectedUsers');
   }
 
   static getConnectedBySlot() {
@@ -549,14 +1053,14 @@ function extractCallDurationFromRow(row) {
 
   // 1) Sélecteur direct le plus fiable
   const direct =
-    row.querySelector('.time-duration') ||
-    row.querySelector('.call-duration') ||
-    row.querySelector('.interaction-duration') ||
-    row.querySelector('.duration') ||
-    row.querySelector('[class*="duration"]') ||
-    row.querySelector('[data-test*="duration"]') ||
-    row.querySelector('.timer') ||
-    row.querySelector('[class*="timer"]');
+    qs(row, '.time-duration') ||
+    qs(row, '.call-duration') ||
+    qs(row, '.interaction-duration') ||
+    qs(row, '.duration') ||
+    qs(row, '[class*="duration"]') ||
+    qs(row, '[data-test*="duration"]') ||
+    qs(row, '.timer') ||
+    qs(row, '[class*="timer"]');
 
   if (direct) {
     const sec = parseDurationSecFromString(direct.innerText || direct.textContent || '');
@@ -580,7 +1084,7 @@ function extractTaskCallDurationFromRow(row) {
     // 1) Icônes téléphone standard (gux-icon, svg aria-label "Voix", etc.)
     let phoneIcon = null;
     for (const sel of PHONE_SELECTORS) {
-      const cand = scope.querySelector(sel);
+      const cand = qs(scope, sel);
       if (cand) {
         phoneIcon = cand;
         break;
@@ -589,7 +1093,8 @@ function extractTaskCallDurationFromRow(row) {
 
     // 2) Icône SVG spécifique dont tu as donné le <path> (receiver)
     if (!phoneIcon) {
-      const pathEl = scope.querySelector(
+      const pathEl = qs(
+        scope,
         'path[d^="M15.0238 10.0096L11.9521 8.694C11.2824 8.40397 10.4932 8.59685 10.0378 9.16119L9.17944 10.2081"]'
       );
       if (pathEl) {
@@ -606,9 +1111,9 @@ function extractTaskCallDurationFromRow(row) {
     // On ne prend que la vraie durée d'appel:
     // la colonne "Durée" des interactions (time-duration / call-duration / interaction-duration)
     const durEl =
-      rowScope.querySelector('.time-duration') ||
-      rowScope.querySelector('.call-duration') ||
-      rowScope.querySelector('.interaction-duration');
+      qs(rowScope, '.time-duration') ||
+      qs(rowScope, '.call-duration') ||
+      qs(rowScope, '.interaction-duration');
 
     if (!durEl) return null;
 
@@ -626,7 +1131,7 @@ function extractTaskCallDurationFromRow(row) {
   let steps = 0;
   while (sib && steps < 8) {
     const looksLikeAgentRow =
-      sib.querySelector('.agentName a, .agentName .dt-cell-value a, [data-col-id="agent"] a');
+      qs(sib, '.agentName a, .agentName .dt-cell-value a, [data-col-id="agent"] a');
     if (looksLikeAgentRow) break;
 
     sec = scan(sib);
@@ -650,7 +1155,7 @@ function extractDurationNear(root, iconSelectors) {
 
     let icon = null;
     for (const sel of iconSelectors) {
-      const found = scope.querySelector(sel);
+      const found = qs(scope, sel);
       if (found) {
         icon = found;
         break;
@@ -670,7 +1175,7 @@ function extractDurationNear(root, iconSelectors) {
 
     // 1) Cherche un élément de durée explicite dans ce scope
     for (const sel of CALL_DURATION_SELECTORS) {
-      const el = durScope.querySelector(sel);
+      const el = qs(durScope, sel);
       if (el) {
         const sec = parseDurationSecFromString(el.innerText || el.textContent || '');
         if (sec != null) return sec;
@@ -693,7 +1198,7 @@ function extractDurationNear(root, iconSelectors) {
   let steps = 0;
   while (sib && steps < 8) {
     const looksLikeAgentRow =
-      sib.querySelector('.agentName a, .agentName .dt-cell-value a, [data-col-id="agent"] a');
+      qs(sib, '.agentName a, .agentName .dt-cell-value a, [data-col-id="agent"] a');
     if (looksLikeAgentRow) break;
 
     sec = scan(sib);
@@ -717,15 +1222,15 @@ function extractChatDurationsFromAgentRow(row) {
       .concat(SMS_SELECTORS)
       .concat(EMAIL_SELECTORS);
 
-    const icons = iconSelectors.flatMap(sel => Array.from(scope.querySelectorAll(sel)));
+    const icons = iconSelectors.flatMap(sel => Array.from(qsa(scope, sel)));
     icons.forEach(ic => {
       const r =
         ic.closest('.dt-row[role="row"], tr[role="row"], .dt-row') ||
         scope;
       const durEl =
-        r.querySelector('.time-duration') ||
-        r.querySelector('.duration') ||
-        r.querySelector('[class*="duration"]');
+        qs(r, '.time-duration') ||
+        qs(r, '.duration') ||
+        qs(r, '[class*="duration"]');
 
       const txt = durEl && (durEl.innerText || durEl.textContent || '');
       const sec = parseDurationSecFromString(txt);
@@ -744,7 +1249,7 @@ function extractChatDurationsFromAgentRow(row) {
   let steps = 0;
   while (out.length < 2 && sib && steps < 8) {
     const looksLikeAgentRow =
-      sib.querySelector('.agentName a, .agentName .dt-cell-value a, [data-col-id="agent"] a');
+      qs(sib, '.agentName a, .agentName .dt-cell-value a, [data-col-id="agent"] a');
     if (looksLikeAgentRow) break; // on a atteint l’agent suivant
     scan(sib);
     steps++;
@@ -759,12 +1264,12 @@ function extractStatusDurationFromRow(row) {
 
   // Vise d'abord la colonne de statut si on la trouve
   const statusCell =
-    row.querySelector('.status .dt-cell-value, .status, [data-col-id="status"]') || row;
+    qs(row, '.status .dt-cell-value, .status, [data-col-id="status"]') || row;
 
   // 1) Sélecteur direct le plus fiable
   const el =
-    statusCell.querySelector('.unescaped-html-cell') ||
-    row.querySelector('.unescaped-html-cell');
+    qs(statusCell, '.unescaped-html-cell') ||
+    qs(row, '.unescaped-html-cell');
 
   if (el) {
     const sec = parseDurationSecFromString(el.innerText || el.textContent || '');
@@ -792,7 +1297,7 @@ function nearestNumber(el) {
 
 function detectChatCount(block) {
   let count = 0;
-  const icons = CHAT_SELECTORS.flatMap(sel => Array.from(block.querySelectorAll(sel)));
+  const icons = CHAT_SELECTORS.flatMap(sel => Array.from(qsa(block, sel)));
   if (icons.length) {
     const n = nearestNumber(icons[0]);
     if (Number.isInteger(n)) count = n;
@@ -830,7 +1335,7 @@ function detectChannelFromRow(row, presenceLabel) {
   let chatCount = 0;
 
   // 1) Icône chat + nombre > 0 dans la même cellule
-  const chatIcon = CHAT_SELECTORS.map(sel => row.querySelector(sel)).find(Boolean);
+  const chatIcon = CHAT_SELECTORS.map(sel => qs(row, sel)).find(Boolean);
   if (chatIcon) {
     const scope =
       chatIcon.closest('td,th,div,span') ||
@@ -870,7 +1375,7 @@ function detectChannelFromRow(row, presenceLabel) {
   }
 
   // ==== EMAIL : ne déclenche chat QUE s'il y a vraiment une interaction ====
-  const emailIcon = EMAIL_SELECTORS.map(sel => row.querySelector(sel)).find(Boolean);
+  const emailIcon = EMAIL_SELECTORS.map(sel => qs(row, sel)).find(Boolean);
   if (emailIcon) {
     const n = nearestNumber(emailIcon);
     if (Number.isInteger(n) && n > 0) {
@@ -888,7 +1393,7 @@ function detectChannelFromRow(row, presenceLabel) {
   }
 
   // ==== SMS : pareil, uniquement si activité réelle ====
-  const smsIcon = SMS_SELECTORS.map(sel => row.querySelector(sel)).find(Boolean);
+  const smsIcon = SMS_SELECTORS.map(sel => qs(row, sel)).find(Boolean);
   if (smsIcon) {
     const n = nearestNumber(smsIcon);
     if (Number.isInteger(n) && n > 0) {
@@ -906,7 +1411,7 @@ function detectChannelFromRow(row, presenceLabel) {
   }
 
   // ==== TÂCHE ASSOCIÉE ====
-  const taskIcon = TASK_SELECTORS.map(sel => row.querySelector(sel)).find(Boolean);
+  const taskIcon = TASK_SELECTORS.map(sel => qs(row, sel)).find(Boolean);
   if (
     taskIcon ||
     /\b(work ?item|t(?:â|a)che(?:\s+associée)?)\b/i.test(label) ||
@@ -919,121 +1424,285 @@ function detectChannelFromRow(row, presenceLabel) {
 }
 
 
-// Hover auto sur les ronds de présence du rapport
-function collectHoverTargets() {
-    const targets = new Set();
-    getAllDocs().forEach(doc => {
-        // Dots de présence dans le rapport (vue tableau)
-        doc.querySelectorAll('.presenceIndicator .entity-v3-presence-indicator-dot, .presenceIndicator [class*="presence-indicator-dot"]')
-            .forEach(el => {
-                if (el && el.isConnected) targets.add(el);
-            });
-
-        // Sélecteurs de secours sur les lignes du rapport
-        doc.querySelectorAll('.dt-row[role="row"] .presenceIndicator, .dt-row[role="row"] [class*="presence-indicator-dot"]')
-            .forEach(el => {
-                if (el && el.isConnected) targets.add(el);
-            });
+// ===================== HOVER CIBLÉ (mini-cards) =====================
+// Genesys ne remplit la mini-card d'un agent qu'au survol de son rond de présence.
+// On ne survole que les agents dont la mini-card manque ou est périmée, par lots :
+// lecture de tous les rects du lot, puis dispatch (une seule mise en page par lot),
+// dans requestIdleCallback et dans la limite de HOVER_BUDGET_MS par frame.
+
+const HOVER_DOT_SELECTOR =
+  '.presenceIndicator .entity-v3-presence-indicator-dot, .presenceIndicator [class*="presence-indicator-dot"]';
+
+let hoverLast    = new Map(); // nom → { at, statusClass } du dernier survol
+let hoverQueue   = [];        // [{ name, row, statusClass }] en attente de dispatch
+let hoverIdleId  = null;
+let hoverPlannedAt = 0;
+let hoverStats   = { planned: 0, dispatched: 0, slices: 0 };
+
+class HoverScheduler {
+  static start() {
+    log.info('[QM-R] Hover ciblé sur les ronds activé (rapport)');
+    document.addEventListener('visibilitychange', () => {
+      if (document.hidden) this.cancel();
     });
-    return Array.from(targets);
-}
-
-function startHoverSimulation() {
-    log.info('[QM-R] Hover auto sur les ronds activé (rapport)');
-    setInterval(() => {
-        const targets = collectHoverTargets();
-        targets.forEach(el => {
-            try {
-                const rect = el.getBoundingClientRect();
-                if (rect.width <= 0 || rect.height <= 0) return;
-
-                const view = el.ownerDocument.defaultView || window;
-                const x = rect.left + rect.width / 2;
-                const y = rect.top + rect.height / 2;
-
-                const over = new view.MouseEvent('mouseover', {
-                    bubbles: true,
-                    cancelable: true,
-                    clientX: x,
-                    clientY: y,
-                    view
-                });
-                const move = new view.MouseEvent('mousemove', {
-                    bubbles: true,
-                    cancelable: true,
-                    clientX: x,
-                    clientY: y,
-                    view
-                });
-
-                el.dispatchEvent(over);
-                el.dispatchEvent(move);
-            } catch (e) {
-                // on ignore les erreurs cross-doc/cleanup
-            }
-        });
-    }, 3000);
+  }
+
+  // Mini-card absente → on retente au rythme HOVER_RETRY_MS ;
+  // présente → on rafraîchit après HOVER_STALE_MS ou si le statut a changé.
+  static needsHover(agent, now) {
+    const last = hoverLast.get(agent.name);
+    if (!last) return true;
+    if (!hasMiniCard(agent.name)) return now - last.at >= CONFIG.HOVER_RETRY_MS;
+    if (last.statusClass !== agent.statusClass) return true;
+    return now - last.at >= CONFIG.HOVER_STALE_MS;
+  }
+
+  // Appelé par processAgents (leader) : la cadence suit donc effectiveRefreshMs()
+  static plan(agents) {
+    if (!isLeaderTab || document.hidden) return;
+    const now = Date.now();
+    if (now - hoverPlannedAt < effectiveRefreshMs()) return;
+    hoverPlannedAt = now;
+
+    const queued = new Set(hoverQueue.map(t => t.name));
+    agents.forEach(agent => {
+      if (queued.has(agent.name) || !agent.rowElement) return;
+      if (!this.needsHover(agent, now)) return;
+      hoverQueue.push({ name: agent.name, row: agent.rowElement, statusClass: agent.statusClass });
+      queued.add(agent.name);
+      hoverStats.planned++;
+    });
+    this.kick();
+  }
+
+  static kick() {
+    if (hoverIdleId != null || !hoverQueue.length) return;
+    hoverIdleId = window.requestIdleCallback
+      ? requestIdleCallback(d => this.run(d), { timeout: CONFIG.HOVER_IDLE_TIMEOUT })
+      : setTimeout(() => this.run(null), 50);
+  }
+
+  static cancel() {
+    if (hoverIdleId == null) return;
+    if (window.cancelIdleCallback) cancelIdleCallback(hoverIdleId);
+    clearTimeout(hoverIdleId);
+    hoverIdleId = null;
+  }
+
+  static run(deadline) {
+    hoverIdleId = null;
+    if (!isLeaderTab || document.hidden) return;
+
+    const t0 = performance.now();
+    const hasTime = () =>
+      performance.now() - t0 < CONFIG.HOVER_BUDGET_MS &&
+      (!deadline || deadline.didTimeout || deadline.timeRemaining() > 1);
+
+    hoverStats.slices++;
+    while (hoverQueue.length && hasTime()) {
+      const batch = hoverQueue.splice(0, CONFIG.HOVER_BATCH);
+
+      // 1) Lectures seules
+      const hits = [];
+      batch.forEach(t => {
+        if (!t.row.isConnected) return;
+        const dot = t.row.querySelector(HOVER_DOT_SELECTOR);
+        if (!dot) return;
+        const rect = dot.getBoundingClientRect();
+        if (rect.width <= 0 || rect.height <= 0) return;
+        hits.push({ t, dot, x: rect.left + rect.width / 2, y: rect.top + rect.height / 2 });
+      });
+
+      // 2) Écritures (events) : plus aucune lecture de layout dans ce lot
+      const now = Date.now();
+      hits.forEach(({ t, dot, x, y }) => {
+        try {
+          const view = dot.ownerDocument.defaultView || window;
+          const init = { bubbles: true, cancelable: true, clientX: x, clientY: y, view };
+          dot.dispatchEvent(new view.MouseEvent('mouseover', init));
+          dot.dispatchEvent(new view.MouseEvent('mousemove', init));
+          hoverStats.dispatched++;
+        } catch (e) {
+          // on ignore les erreurs cross-doc/cleanup
+        }
+      });
+      // Rond introuvable/invisible compris : on attend le prochain plan avant de réessayer
+      batch.forEach(t => hoverLast.set(t.name, { at: now, statusClass: t.statusClass }));
+    }
+    this.kick();
+  }
+
+  static reset() {
+    this.cancel();
+    hoverLast = new Map();
+    hoverQueue = [];
+    hoverPlannedAt = 0;
+  }
+}
+
+// ===================== SCAN INCRÉMENTAL DES LIGNES =====================
+// Chaque ligne du rapport garde son agent parsé. Le MutationObserver marque
+// les lignes modifiées ; un tick ne re-parse que celles-ci.
+
+const ROW_SELECTOR = '.dt-row[role="row"], tr[role="row"]';
+
+// Éléments dont le texte change chaque seconde mais qui sont relus à chaque tick
+// par les extract*Duration : inutile de re-parser la ligne pour eux.
+// (durées d'appel/chat + durée de statut lue par extractStatusDurationFromRow)
+const ROW_VOLATILE_SELECTOR = CALL_DURATION_SELECTORS
+  .concat(['.unescaped-html-cell'])
+  .join(', ');
+
+let rowRecords     = new WeakMap(); // row → agent parsé (null = pas une ligne agent)
+let rowsByDoc      = new WeakMap(); // doc → [rows], figée jusqu'à ajout/suppression de ligne
+let observedDocs   = new WeakSet();
+let dirtyRows      = new Set();
+let lastFullScanAt = 0;
+let scanStats      = { rows: 0, parsed: 0, full: false, miniCardBuilds: 0, selectorCalls: 0 };
+
+class RowScanner {
+  static observeDoc(doc) {
+    if (!reportObserver || observedDocs.has(doc) || !doc.body) return;
+    try {
+      reportObserver.observe(doc.body, REPORT_OBSERVER_OPTIONS);
+      observedDocs.add(doc);
+      rowsByDoc.delete(doc);
+    } catch (e) {
+      // doc en cours de déchargement → on réessaiera au prochain tick
+    }
+  }
+
+  static markMutation(m) {
+    const node = m.target.nodeType === 1 ? m.target : m.target.parentElement;
+    if (!node) return;
+
+    if (m.type === 'childList') {
+      const changed = [...m.addedNodes, ...m.removedNodes].filter(n => n.nodeType === 1);
+      if (changed.some(n => n.matches(ROW_SELECTOR) || n.querySelector?.(ROW_SELECTOR))) {
+        rowsByDoc.delete(node.ownerDocument);
+      }
+      if (changed.some(n => n.matches(MINI_CARD_SELECTOR) || n.querySelector?.(MINI_CARD_SELECTOR))) {
+        invalidateMiniCards();
+      }
+    }
+    if (miniCardIndex && node.closest(MINI_CARD_SELECTOR)) invalidateMiniCards();
+
+    if (m.type !== 'attributes' && node.closest(ROW_VOLATILE_SELECTOR)) return;
+    const row = node.closest(ROW_SELECTOR);
+    if (row) dirtyRows.add(row);
+  }
+
+  static beginTick() {
+    const full = (Date.now() - lastFullScanAt) >= CONFIG.ROW_FULL_RESCAN_MS;
+    if (full) {
+      lastFullScanAt = Date.now();
+      invalidateMiniCards();
+    }
+    scanStats = { rows: 0, parsed: 0, full, miniCardBuilds: 0, selectorCalls: 0 };
+    return full;
+  }
+
+  static rowsOf(doc, full) {
+    this.observeDoc(doc);
+    let rows = rowsByDoc.get(doc);
+    if (!rows || full) {
+      rows = Array.from(qsa(doc, ROW_SELECTOR));
+      rowsByDoc.set(doc, rows);
+    }
+    return rows;
+  }
+
+  static recordOf(row, full) {
+    scanStats.rows++;
+    if (!full && !dirtyRows.has(row) && rowRecords.has(row)) {
+      return rowRecords.get(row);
+    }
+    scanStats.parsed++;
+    const rec = parseAgentRow(row);
+    rowRecords.set(row, rec);
+    dirtyRows.delete(row);
+    return rec;
+  }
+
+  static endTick() {
+    // Lignes marquées mais détachées du DOM : plus jamais relues
+    dirtyRows.forEach(row => { if (!row.isConnected) dirtyRows.delete(row); });
+  }
+
+  static reset() {
+    rowRecords = new WeakMap();
+    rowsByDoc = new WeakMap();
+    dirtyRows = new Set();
+    lastFullScanAt = 0;
+  }
 }
 
 // ===================== AGENTS: UNIQUEMENT VIA LE RAPPORT =====================
 
+// Parse une ligne du rapport → agent (sans activityCount/timestamp, recalculés à chaque tick)
+function parseAgentRow(row) {
+  const nameEl =
+    qs(row, '.agentName a') ||
+    qs(row, '.agentName .dt-cell-value a') ||
+    qs(row, 'a[href*="#/agents/"]') ||
+    qs(row, 'a[href*="#/person/"]') ||
+    qs(row, '.dt-cell.agentName, .dt-cell .agent-name') ||
+    qs(row, '[data-col-id="agent"] a');
+
+  if (!nameEl) return null;
+  const name = (nameEl.textContent || '').trim();
+  if (!name) return null;
+
+  // Statut texte et dot
+  const dot =
+    qs(row, '.presenceIndicator .entity-v3-presence-indicator-dot') ||
+    qs(row, '.presenceIndicator [class*="presence-indicator-dot"]');
+
+  const statusCell =
+    qs(row, '.status.status-picker .dt-cell-value') ||
+    qs(row, '.status .dt-cell-value') ||
+    qs(row, '.status') ||
+    qs(row, '[data-col-id="status"]');
+
+  const statusText = statusCell ? (statusCell.textContent || '').trim() : '';
+  const statusClass = getStatusClassFromDot(dot, statusText);
+
+  const onQueue =
+    /queue|file/i.test(statusText) ||
+    (dot && String(dot.className).toLowerCase().includes('on_queue')) ||
+    statusClass === 'On Queue';
+
+  const channel = detectChannelFromRow(row, statusText || statusClass || '');
+
+  return {
+    id: 'report_' + norm(name),
+    name,
+    status: statusText || statusClass || '',
+    statusClass: statusClass || 'default',
+    activityCount: 0,
+    onQueue,
+    channel,
+    rowElement: row,
+    timestamp: 0
+  };
+}
+
 function findAgentsInReportOnly() {
   const agents = [];
   const seen = new Set();
+  const full = RowScanner.beginTick();
 
   getAllDocs().forEach(doc => {
-    const rows = doc.querySelectorAll('.dt-row[role="row"], tr[role="row"]');
-    rows.forEach(row => {
+    RowScanner.rowsOf(doc, full).forEach(row => {
       try {
-        const nameEl =
-          row.querySelector('.agentName a') ||
-          row.querySelector('.agentName .dt-cell-value a') ||
-          row.querySelector('a[href*="#/agents/"]') ||
-          row.querySelector('a[href*="#/person/"]') ||
-          row.querySelector('.dt-cell.agentName, .dt-cell .agent-name') ||
-          row.querySelector('[data-col-id="agent"] a');
-
-        if (!nameEl) return;
-        const name = (nameEl.textContent || '').trim();
-        if (!name || seen.has(name)) return;
-
-        // Statut texte et dot
-        const dot =
-          row.querySelector('.presenceIndicator .entity-v3-presence-indicator-dot') ||
-          row.querySelector('.presenceIndicator [class*="presence-indicator-dot"]');
-
-        const statusCell =
-          row.querySelector('.status.status-picker .dt-cell-value') ||
-          row.querySelector('.status .dt-cell-value') ||
-          row.querySelector('.status') ||
-          row.querySelector('[data-col-id="status"]');
-
-        const statusText = statusCell ? (statusCell.textContent || '').trim() : '';
-        const statusClass = getStatusClassFromDot(dot, statusText);
+        const agent = RowScanner.recordOf(row, full);
+        if (!agent || seen.has(agent.name)) return;
 
         // Activité via mini-card (nouvelle méthode)
-        const activityCount = getActivityCountFromMiniCard(name);
-
-        const onQueue =
-          /queue|file/i.test(statusText) ||
-          (dot && String(dot.className).toLowerCase().includes('on_queue')) ||
-          statusClass === 'On Queue';
-
-        const channel = detectChannelFromRow(row, statusText || statusClass || '');
-
-        const agent = {
-          id: 'report_' + norm(name),
-          name,
-          status: statusText || statusClass || '',
-          statusClass: statusClass || 'default',
-          activityCount,
-          onQueue,
-          channel,
-          rowElement: row,
-          timestamp: Date.now()
-        };
+        agent.activityCount = getActivityCountFromMiniCard(agent.name);
+        agent.timestamp = Date.now();
 
-        seen.add(name);
+        seen.add(agent.name);
         agents.push(agent);
       } catch (e) {
         log.error('Erreur extraction agent rapport:', e);
@@ -1041,55 +1710,34 @@ function findAgentsInReportOnly() {
     });
   });
 
+  RowScanner.endTick();
   return agents;
 }
 
 // ===================== MAPPAGE STATUT → SECTION (deriveStatusKey) =====================
 
 function deriveStatusKey(agent) {
-  const raw = agent.status || agent.statusClass || '';
-  const st = raw.toLowerCase();
-  const noacc = norm(raw);
+  const status = classifyStatus(agent.status || agent.statusClass || '');
   const ch = agent.channel || {};
   const onQ = !!agent.onQueue;
   const cnt = agent.activityCount || 0;
 
-  // Prohibés en premier
-  if (isRonaStatus(raw) || isPostcallStatus(raw)) return 'prohib';
-
-  // Statuts textuels qui doivent DOMINER l’auto-détection
-  if (
-    st.includes('tâche') || st.includes('tache') ||
-    noacc.includes('tache associee') ||
-    st.includes('work item') || st.includes('workitem') ||
-    st.includes('associated task')
-  ) return 'tache';
+  // Prohibés puis statuts textuels qui doivent DOMINER l’auto-détection (STATUS_KEY_RULES)
+  if (status.key) return status.key;
 
-  if (
-    st.includes('non télé') || st.includes('non-télé') ||
-    noacc.includes('non telecontact') || noacc.includes('non-telecontact') ||
-    noacc.includes('non tele contact') || noacc.includes('non telec')
-  ) return 'non_telecontact';
-
-  if (st.includes('pause') || st.includes('break')) return 'pause';
-  if (st.includes('repas') || st.includes('meal')) return 'repas';
-  if (st.includes('réunion') || st.includes('reunion') || st.includes('meeting')) return 'reunion';
-  if (st.includes('formation') || st.includes('training')) return 'formation';
-  if (st.includes('travaux pay')) return 'travaux';
-
-      // Digital / voix
+  // Digital / voix
   if (ch.chat) return 'en_chat';
 
   // Voix uniquement si Genesys nous indique explicitement un appel
   // (canal voix détecté, statusClass On Call, ou texte "En interaction")
-  if (ch.call || agent.statusClass === 'On Call' || st.includes('interaction')) return 'en_call';
+  if (ch.call || agent.statusClass === 'On Call' || status.interaction) return 'en_call';
 
   // File sans interaction
   if (onQ && cnt === 0) return 'queue_free';
 
   // Disponibles / interactions hors file
   if (!onQ && cnt > 0) return 'interaction_hf';
-  if (!onQ && (st.includes('available') || st.includes('disponible'))) return 'disponible';
+  if (!onQ && status.available) return 'disponible';
 
   return 'autre';
 }
@@ -1097,7 +1745,7 @@ function deriveStatusKey(agent) {
 
 // ===================== TIMERS STATUT / CALL / CHAT =====================
 
-function ensureStatusTimerOnly(key, name) {
+function ensureStatusTimerOnly(key, name, status) {
   if (!name) return;
   const prevKey = lastStatusKey[name];
 
@@ -1112,7 +1760,7 @@ function ensureStatusTimerOnly(key, name) {
   }
 
   if (key === 'prohib' && prevKey !== 'prohib') {
-    const sub = prohibSubtypeFromStatus((key && key.status) || '');
+    const sub = prohibSubtypeFromStatus(status || '');
     lastProhibSubtype[name] = sub;
     histAdd(name, 'prohib_on', { sub });
   }
@@ -1123,7 +1771,7 @@ function ensureStatusTimerOnly(key, name) {
     histAdd(name, 'status', { to: key });
   }
 
-  save();
+  save('lastStatusKey', 'statusStartAt', 'lastProhibSubtype');
 }
 
 function updateCallState(name, inCallConnected, genesysSec) {
@@ -1162,7 +1810,7 @@ function updateCallState(name, inCallConnected, genesysSec) {
     }
   }
 
-  save();
+  save('callStartAt', 'lastInCall', 'callOffStreak');
 }
 
 // Version simplifiée: on suit juste un compteur de chats actifs par agent
@@ -1209,7 +1857,7 @@ function updateChatState(name, chatCount) {
     chatOffStreak[name] = chatOffStreak[name].slice(0, chatCount);
   }
 
-  save();
+  save('chatStartAt', 'lastInChat', 'chatOffStreak');
 }
 
 // ===================== KPIs =====================
@@ -1516,7 +2164,7 @@ function createMinimizedButton() {
   });
   minimizedBtn.onclick = () => {
     minimized = false;
-    save();
+    save('minimized');
     if (panel) panel.classList.remove('qm-hidden');
     minimizedBtn.style.display = 'none';
     setTimeout(() => {
@@ -1591,7 +2239,7 @@ function createPanel() {
     panel.style.top = y + 'px';
     panel.style.right = 'auto';
     panelPos = { left: panel.style.left, top: panel.style.top };
-    save();
+    save('panelPos');
   });
 
   panel._setupDragHandler = setupDrag;
@@ -1600,15 +2248,35 @@ function createPanel() {
 
 // ====== HEADER & RENDERING ======
 
-function headerHtml(kpis) {
+function bellState() {
   const alertsCount = activeAlerts.total || 0;
-  const bellCls =
-    'bell qm-nodrag ' +
-    ((muted || (Date.now() < (snoozeUntil || 0))) ? 'muted' : '');
   const snoozeTxt =
     (Date.now() < (snoozeUntil || 0))
       ? ' (⏱️ ' + Math.ceil((snoozeUntil - Date.now()) / 60000) + 'm)'
       : '';
+  return {
+    cls: 'bell qm-nodrag ' + ((muted || (Date.now() < (snoozeUntil || 0))) ? 'muted' : ''),
+    title: 'Alertes' + snoozeTxt,
+    text: alertsCount ? '🔔 ' + alertsCount : '🔔'
+  };
+}
+
+function kpisHtml(kpis) {
+  return (
+    '<span class="kpi-chip">👥 ' + kpis.connected + ' agents</span>' +
+    '<span class="kpi-chip">🟢 On Queue ' + kpis.onQueue + '</span>' +
+    '<span class="kpi-chip">🔵 Longest call ' +
+      (kpis.longestCall.name ? (kpis.longestCall.name + ' ' + toHMS(kpis.longestCall.ms)) : '—') +
+    '</span>' +
+    '<span class="kpi-chip">💬 Longest chat ' +
+      (kpis.longestChat.name ? (kpis.longestChat.name + ' ' + toHMS(kpis.longestChat.ms)) : '—') +
+    '</span>' +
+    '<span class="kpi-chip">⛔ Prohibés ' + kpis.prohibCount + '</span>'
+  );
+}
+
+function headerHtml(kpis) {
+  const bell = bellState();
 
   return (
     '<div id="panel-header" style="background:linear-gradient(90deg,#4f46e5,#7c3aed);' +
@@ -1653,8 +2321,8 @@ function headerHtml(kpis) {
           '<button id="q-reset" type="button" class="qm-nodrag" title="Réinitialiser" ' +
             'style="height:26px;border:none;border-radius:6px;padding:0 8px;' +
                    'background:rgba(255,255,255,.25);color:white;cursor:pointer;">🔄</button>' +
-          '<button id="qm-bell" type="button" class="' + bellCls + '" title="Alertes' + snoozeTxt + '">' +
-            (alertsCount ? '🔔 ' + alertsCount : '🔔') +
+          '<button id="qm-bell" type="button" class="' + bell.cls + '" title="' + bell.title + '">' +
+            bell.text +
           '</button>' +
         '</div>' +
       '</div>' +
@@ -1679,15 +2347,7 @@ function headerHtml(kpis) {
     '</div>' +
     '<div id="panel-kpis" style="padding:6px 12px;display:flex;flex-wrap:wrap;gap:6px;' +
            'align-items:center;border-bottom:1px solid rgba(0,0,0,.05);">' +
-      '<span class="kpi-chip">👥 ' + kpis.connected + ' agents</span>' +
-      '<span class="kpi-chip">🟢 On Queue ' + kpis.onQueue + '</span>' +
-      '<span class="kpi-chip">🔵 Longest call ' +
-        (kpis.longestCall.name ? (kpis.longestCall.name + ' ' + toHMS(kpis.longestCall.ms)) : '—') +
-      '</span>' +
-      '<span class="kpi-chip">💬 Longest chat ' +
-        (kpis.longestChat.name ? (kpis.longestChat.name + ' ' + toHMS(kpis.longestChat.ms)) : '—') +
-      '</span>' +
-      '<span class="kpi-chip">⛔ Prohibés ' + kpis.prohibCount + '</span>' +
+      kpisHtml(kpis) +
     '</div>'
   );
 }
@@ -1816,23 +2476,108 @@ function renderAgentCard(agent, showSlot, statusKey) {
   );
 }
 
-function renderSection(title, list, emoji, key, showSlot) {
-  if (!list || !list.length || sectionVisibility[key] === false) return '';
-  const favs = list.filter(a => favorites.has(a.name));
-  const others = list.filter(a => !favorites.has(a.name));
-  const final = favs.concat(others);
-  return (
-    '<div style="margin:12px 0;">' +
-      '<div style="font-weight:700;color:#374151;margin-bottom:6px;display:flex;align-items:center;gap:6px;">' +
-        '<span>' + emoji + '</span>' +
-        '<span>' + title + '</span>' +
-        '<span style="background:#f3f4f6;padding:2px 6px;border-radius:10px;font-size:11px;font-weight:normal;">' +
-          final.length +
-        '</span>' +
-      '</div>' +
-      final.map(a => renderAgentCard(a, showSlot, key)).join('') +
-    '</div>'
-  );
+// Ce qui change l'apparence d'une carte, hors texte des timers (mis à jour par visualTick)
+function cardSignature(agent, showSlot, statusKey) {
+  const name = agent.name;
+  const inCall = !!(lastInCall[name] && callStartAt[name]);
+  const chats = Array.isArray(chatStartAt[name])
+    ? chatStartAt[name].map(s => (s ? 1 : 0)).join('')
+    : '';
+  const pulse = inCall && msSince(callStartAt[name]) >= CONFIG.CALL_ALERT_SECS * 1000;
+  return [
+    statusKey,
+    favorites.has(name) ? 1 : 0,
+    showSlot ? SlotManager.getSlot(name) : '',
+    agent.status || agent.statusClass || '',
+    inCall ? 1 : 0,
+    chats,
+    pulse ? 1 : 0,
+    agent.activityCount || 0,
+    histStamp(name)
+  ].join('|');
+}
+
+function htmlToNode(html) {
+  const tpl = document.createElement('template');
+  tpl.innerHTML = html;
+  return tpl.content.firstElementChild;
+}
+
+const setText = (el, v) => { if (el.textContent !== v) el.textContent = v; };
+const setDisplay = (el, v) => { if (el.style.display !== v) el.style.display = v; };
+
+// Réconcilie une section : cartes réutilisées (clé = nom), reconstruites si leur
+// signature change, déplacées si leur position change.
+function patchSection(key, list, showSlot, used) {
+  const sec = ui.sections[key];
+  const visible = !!(list && list.length) && sectionVisibility[key] !== false;
+  const final = visible
+    ? list.filter(a => favorites.has(a.name)).concat(list.filter(a => !favorites.has(a.name)))
+    : [];
+
+  setDisplay(sec.el, visible ? '' : 'none');
+  setText(sec.count, String(final.length));
+
+  // Favoris = doublon d'une carte d'une autre section → clé séparée
+  const prefix = key === 'favoris' ? 'fav:' : 'card:';
+
+  // 1) Cartes (re)construites sur place, sans encore toucher à l'ordre
+  const entries = final.map(agent => {
+    const id = prefix + agent.name;
+    const sig = cardSignature(agent, showSlot, key);
+    let entry = ui.cards.get(id);
+    if (!entry || entry.sig !== sig) {
+      const node = htmlToNode(renderAgentCard(agent, showSlot, key));
+      if (entry) entry.node.replaceWith(node);
+      entry = { node, sig };
+      ui.cards.set(id, entry);
+      uiStats.cardsBuilt++;
+    }
+    used.add(id);
+    return entry;
+  });
+
+  // 2) Cartes sorties de la section détachées AVANT placement : un départ en tête
+  // ne décale pas toutes les suivantes (sinon N−1 insertBefore)
+  const keep = new Set(entries.map(e => e.node));
+  Array.from(sec.list.children).forEach(node => {
+    if (!keep.has(node)) node.remove();
+  });
+
+  // 3) Placement : les cartes déjà dans le bon ordre relatif ne bougent pas,
+  // seules les autres sont insérées (de la fin vers le début, devant la suivante)
+  const pos = new Map(Array.from(sec.list.children).map((node, i) => [node, i]));
+  const still = longestOrderedRun(entries.map(e => pos.has(e.node) ? pos.get(e.node) : -1));
+  let anchor = null;
+  for (let i = entries.length - 1; i >= 0; i--) {
+    const node = entries[i].node;
+    if (!still.has(i)) {
+      sec.list.insertBefore(node, anchor);
+      uiStats.cardsMoved++;
+    }
+    anchor = node;
+  }
+}
+
+// Indices de la plus longue sous-suite strictement croissante (valeurs < 0 ignorées)
+function longestOrderedRun(seq) {
+  const tails = []; // tails[k] = indice de fin de la meilleure suite de longueur k+1
+  const prev = new Array(seq.length).fill(-1);
+  seq.forEach((v, i) => {
+    if (v < 0) return;
+    let lo = 0;
+    let hi = tails.length;
+    while (lo < hi) {
+      const mid = (lo + hi) >> 1;
+      if (seq[tails[mid]] < v) lo = mid + 1;
+      else hi = mid;
+    }
+    if (lo > 0) prev[i] = tails[lo - 1];
+    tails[lo] = i;
+  });
+  const out = new Set();
+  for (let i = tails.length ? tails[tails.length - 1] : -1; i >= 0; i = prev[i]) out.add(i);
+  return out;
 }
 
 function renderSlotList() {
@@ -1859,7 +2604,6 @@ function renderSlotList() {
 
 // ====== PRÉSENCES RAPIDES (version adaptée, se base sur les noms déjà connus) ======
 let presenceOpen = false;
-let presenceInterval = null;
 
 function normalizeNameSimple(s) {
   return (s || '')
@@ -1896,10 +2640,7 @@ function togglePresenceTable() {
   } else {
     if (existing) existing.remove();
     localStorage.removeItem('presenceInput');
-    if (presenceInterval) {
-      clearInterval(presenceInterval);
-      presenceInterval = null;
-    }
+    TimerWheel.remove('presence');
   }
 }
 
@@ -1939,10 +2680,7 @@ function renderPresenceTable() {
     div.remove();
     presenceOpen = false;
     localStorage.removeItem('presenceInput');
-    if (presenceInterval) {
-      clearInterval(presenceInterval);
-      presenceInterval = null;
-    }
+    TimerWheel.remove('presence');
   };
 
   const input = document.getElementById('presence-input');
@@ -2006,12 +2744,11 @@ function renderPresenceTable() {
 
   updatePresenceResult(getNamesFromTextarea());
 
-  if (presenceInterval) clearInterval(presenceInterval);
-  presenceInterval = setInterval(() => {
+  TimerWheel.every('presence', 2000, () => {
     if (document.getElementById('presence-table')) {
       updatePresenceResult(getNamesFromTextarea());
     }
-  }, 2000);
+  });
 
   input.addEventListener('input', () => {
     updatePresenceResult(getNamesFromTextarea());
@@ -2070,55 +2807,79 @@ function computeKpisFromGroups(groups) {
   return computeKpis(agents);
 }
 
-function updateUI(groups) {
-  if (!panel || !document.body.contains(panel)) {
-    panel = createPanel();
-  }
-
-  injectPulseStyle();
-  injectUiFixStyles();
-  injectThemeStyles();
-
-  const kpis = computeKpisFromGroups(groups);
-  const header = headerHtml(kpis);
+// Sections affichées, dans l'ordre du panel
+const UI_SECTIONS = [
+  { key: 'favoris',         title: 'Favoris',                    emoji: '⭐' },
+  { key: 'prohib',          title: 'Statut prohibé',             emoji: '⛔' },
+  { key: 'disponible',      title: 'Disponible',                 emoji: '⚪' },
+  { key: 'queue_free',      title: "En file d'attente",          emoji: '🟢' },
+  { key: 'en_call',         title: 'En call',                    emoji: '🔵' },
+  { key: 'en_chat',         title: 'En chat',                    emoji: '💬' },
+  { key: 'tache',           title: 'Tâche associée',             emoji: '📌' },
+  { key: 'non_telecontact', title: 'Non télécontact',            emoji: '🚫' },
+  { key: 'travaux',         title: 'Travaux payants',            emoji: '💼' },
+  { key: 'pause',           title: 'Pause',                      emoji: '☕' },
+  { key: 'repas',           title: 'Repas',                      emoji: '🍽️' },
+  { key: 'reunion',         title: 'Réunion',                    emoji: '📅' },
+  { key: 'formation',       title: 'Formation',                  emoji: '📚' },
+  { key: 'interaction_hf',  title: 'En interaction (hors file)', emoji: '🔴' },
+  { key: 'autre',           title: 'Autre',                      emoji: '🟡' }
+];
 
-  const connectedTotal = Object.values(groups)
-    .reduce((acc, arr) => acc + (arr ? arr.length : 0), 0);
+let ui = null;               // références DOM du panel, construites une seule fois
+let lastRenderedGroups = {}; // groupes du dernier rendu (utilisés par les handlers)
+let uiStats = { cardsBuilt: 0, cardsMoved: 0, cardsRemoved: 0 };
 
-  const content =
+// Squelette persistant : header, sections vides, pied. Les listeners sont posés ici, une fois.
+function buildPanelSkeleton() {
+  panel.innerHTML =
+    headerHtml(computeKpisFromGroups({})) +
     '<div id="panel-content" style="padding:12px;overflow-y:auto;flex:1 1 auto;height:auto;min-height:0;' +
       '-webkit-overflow-scrolling:touch;">' +
-      renderSection('Favoris', groups.favoris || [], '⭐', 'favoris', true) +
-      renderSection('Statut prohibé', groups.prohib || [], '⛔', 'prohib', true) +
-      renderSection('Disponible', groups.disponible || [], '⚪', 'disponible', true) +
-      renderSection("En file d'attente", groups.queue_free || [], '🟢', 'queue_free', true) +
-      renderSection('En call', groups.en_call || [], '🔵', 'en_call', true) +
-      renderSection('En chat', groups.en_chat || [], '💬', 'en_chat', true) +
-      renderSection('Tâche associée', groups.tache || [], '📌', 'tache', true) +
-      renderSection('Non télécontact', groups.non_telecontact || [], '🚫', 'non_telecontact', true) +
-      renderSection('Travaux payants', groups.travaux || [], '💼', 'travaux', true) +
-      renderSection('Pause', groups.pause || [], '☕', 'pause', true) +
-      renderSection('Repas', groups.repas || [], '🍽️', 'repas', true) +
-      renderSection('Réunion', groups.reunion || [], '📅', 'reunion', true) +
-      renderSection('Formation', groups.formation || [], '📚', 'formation', true) +
-      renderSection('En interaction (hors file)', groups.interaction_hf || [], '🔴', 'interaction_hf', true) +
-      renderSection('Autre', groups.autre || [], '🟡', 'autre', true) +
-      (panel._showSlots ? renderSlotList() : '') +
+      UI_SECTIONS.map(s =>
+        '<div class="qm-section" data-section="' + s.key + '" style="margin:12px 0;display:none;">' +
+          '<div style="font-weight:700;color:#374151;margin-bottom:6px;display:flex;align-items:center;gap:6px;">' +
+            '<span>' + s.emoji + '</span>' +
+            '<span>' + s.title + '</span>' +
+            '<span class="qm-section-count" style="background:#f3f4f6;padding:2px 6px;border-radius:10px;' +
+              'font-size:11px;font-weight:normal;">0</span>' +
+          '</div>' +
+          '<div class="qm-section-list"></div>' +
+        '</div>'
+      ).join('') +
+      '<div id="qm-slot-list" style="display:none;"></div>' +
       '<div style="margin-top:12px;padding:8px;background:#f8fafc;border-radius:6px;font-size:11px;color:#64748b;">' +
-        '<span>Connectés: ' + connectedTotal + ' agents</span> • ' +
-        '<span>Slots total: ' + masterSlotList.length + '</span> • ' +
-        '<span>Maj: ' + new Date().toLocaleTimeString() + '</span>' +
+        '<span id="qm-foot-connected"></span> • ' +
+        '<span id="qm-foot-slots"></span> • ' +
+        '<span id="qm-foot-updated"></span>' +
       '</div>' +
     '</div>';
 
-  const prev = panel.querySelector('#panel-content');
-  const prevScroll = prev ? prev.scrollTop : 0;
-  const sectionsWasOpen = sectionsOpenRuntime;
-
-  panel.innerHTML = header + content;
-
-  const cur = panel.querySelector('#panel-content');
-  if (cur) cur.scrollTop = prevScroll;
+  ui = {
+    panel,
+    content: panel.querySelector('#panel-content'),
+    kpis: panel.querySelector('#panel-kpis'),
+    kpisHtml: '',
+    bell: panel.querySelector('#qm-bell'),
+    search: panel.querySelector('#qm-search'),
+    sortCalls: panel.querySelector('#qm-sort-calls'),
+    sortStatus: panel.querySelector('#qm-sort-status'),
+    sectionInputs: Array.from(panel.querySelectorAll('#qm-sections-menu input[data-section]')),
+    sections: {},
+    cards: new Map(),
+    slotList: panel.querySelector('#qm-slot-list'),
+    slotsHtml: '',
+    footConnected: panel.querySelector('#qm-foot-connected'),
+    footSlots: panel.querySelector('#qm-foot-slots'),
+    footUpdated: panel.querySelector('#qm-foot-updated')
+  };
+  panel.querySelectorAll('.qm-section').forEach(el => {
+    ui.sections[el.getAttribute('data-section')] = {
+      el,
+      count: el.querySelector('.qm-section-count'),
+      list: el.querySelector('.qm-section-list')
+    };
+  });
 
   const headerEl = panel.querySelector('#panel-header');
   if (headerEl && panel._setupDragHandler) {
@@ -2147,16 +2908,83 @@ function updateUI(groups) {
     if (panel._setupDragHandler) panel._setupDragHandler(bh);
   })();
 
-  // Boutons et interactions
-  wireHeaderInteractions(groups, sectionsWasOpen);
+  wireHeaderInteractions();
+}
+
+// Header : uniquement les valeurs qui ont changé (jamais un champ en cours d'édition)
+function patchHeader(kpis) {
+  const bell = bellState();
+  if (ui.bell.className !== bell.cls) ui.bell.className = bell.cls;
+  if (ui.bell.title !== bell.title) ui.bell.title = bell.title;
+  setText(ui.bell, bell.text);
+
+  const kh = kpisHtml(kpis);
+  if (ui.kpisHtml !== kh) {
+    ui.kpis.innerHTML = kh;
+    ui.kpisHtml = kh;
+  }
+
+  if (!searchActiveRuntime && ui.search.value !== searchFilter) ui.search.value = searchFilter;
+  if (!selectActiveRuntime) {
+    if (ui.sortCalls.value !== sortCallsOrder) ui.sortCalls.value = sortCallsOrder;
+    if (ui.sortStatus.value !== sortStatusOrder) ui.sortStatus.value = sortStatusOrder;
+  }
+  ui.sectionInputs.forEach(cb => {
+    const on = sectionVisibility[cb.getAttribute('data-section')] !== false;
+    if (cb.checked !== on) cb.checked = on;
+  });
+}
+
+function updateUI(groups) {
+  if (!panel || !document.body.contains(panel)) {
+    panel = createPanel();
+  }
+
+  injectPulseStyle();
+  injectUiFixStyles();
+  injectThemeStyles();
+
+  // Panel recréé (reset, watchdog, hotkey) ou écrasé par le message d'erreur
+  if (!ui || ui.panel !== panel || !panel.contains(ui.content)) {
+    buildPanelSkeleton();
+  }
+
+  lastRenderedGroups = groups;
+  uiStats = { cardsBuilt: 0, cardsMoved: 0, cardsRemoved: 0 };
+
+  patchHeader(computeKpisFromGroups(groups));
+
+  const used = new Set();
+  UI_SECTIONS.forEach(s => patchSection(s.key, groups[s.key] || [], true, used));
+  ui.cards.forEach((entry, id) => {
+    if (used.has(id)) return;
+    entry.node.remove();
+    ui.cards.delete(id);
+    uiStats.cardsRemoved++;
+  });
+  if (uiStats.cardsBuilt || uiStats.cardsRemoved) TimerWheel.invalidate();
+
+  const slotsHtml = panel._showSlots ? renderSlotList() : '';
+  if (ui.slotsHtml !== slotsHtml) {
+    ui.slotList.innerHTML = slotsHtml;
+    ui.slotsHtml = slotsHtml;
+    setDisplay(ui.slotList, slotsHtml ? '' : 'none');
+  }
+
+  const connectedTotal = Object.values(groups)
+    .reduce((acc, arr) => acc + (arr ? arr.length : 0), 0);
+  setText(ui.footConnected, 'Connectés: ' + connectedTotal + ' agents');
+  setText(ui.footSlots, 'Slots total: ' + masterSlotList.length);
+  setText(ui.footUpdated, 'Maj: ' + new Date().toLocaleTimeString());
+
   addPresenceButton();
   if (presenceOpen) {
     renderPresenceTable();
   }
 }
 
-// Wire header (séparé pour clarté)
-function wireHeaderInteractions(groups, sectionsWasOpen) {
+// Wire header (séparé pour clarté) — appelé une seule fois par squelette
+function wireHeaderInteractions() {
   const resetBtn = panel.querySelector('#q-reset');
   if (resetBtn) {
     resetBtn.onclick = doReset;
@@ -2164,12 +2992,15 @@ function wireHeaderInteractions(groups, sectionsWasOpen) {
 
   const slotsBtn = panel.querySelector('#q-slots');
   if (slotsBtn) {
+    slotsBtn.style.background = panel._showSlots
+      ? 'rgba(255,255,255,0.4)'
+      : 'rgba(255,255,255,0.25)';
     slotsBtn.onclick = () => {
       panel._showSlots = !panel._showSlots;
       slotsBtn.style.background = panel._showSlots
         ? 'rgba(255,255,255,0.4)'
         : 'rgba(255,255,255,0.25)';
-      updateUI(groups);
+      updateUI(lastRenderedGroups);
     };
   }
 
@@ -2200,8 +3031,8 @@ function wireHeaderInteractions(groups, sectionsWasOpen) {
           muted = false;
           snoozeUntil = Date.now() + mins * 60000;
         }
-        save();
-        updateUI(groups);
+        save('muted', 'snoozeUntil');
+        updateUI(lastRenderedGroups);
       };
     });
 
@@ -2225,8 +3056,7 @@ function wireHeaderInteractions(groups, sectionsWasOpen) {
   const sectionsBtn = panel.querySelector('#qm-sections');
   const sectionsMenu = panel.querySelector('#qm-sections-menu');
   if (sectionsBtn && sectionsMenu) {
-    sectionsMenu.style.display = sectionsWasOpen ? 'block' : 'none';
-    sectionsOpenRuntime = sectionsWasOpen;
+    sectionsMenu.style.display = sectionsOpenRuntime ? 'block' : 'none';
 
     sectionsBtn.onclick = e => {
       e.stopPropagation();
@@ -2255,10 +3085,9 @@ function wireHeaderInteractions(groups, sectionsWasOpen) {
     sectionsMenu.querySelectorAll('input[data-section]').forEach(cb => {
       cb.onchange = () => {
         const key = cb.getAttribute('data-section');
-        sectionVisibility[key] = cb.checked;
-        save();
+        setPref({ section: key, visible: cb.checked });
         sectionsOpenRuntime = true;
-        updateUI(groups);
+        updateUI(lastRenderedGroups);
       };
     });
   }
@@ -2273,13 +3102,13 @@ function wireHeaderInteractions(groups, sectionsWasOpen) {
       clearTimeout(searchDebounceTimer);
       searchDebounceTimer = setTimeout(() => {
         searchFilter = searchEl.value.trim();
-        save();
+        save('searchFilter');
       }, 200);
     };
     searchEl.onkeydown = e => {
       if (e.key === 'Enter') {
         searchFilter = searchEl.value.trim();
-        save();
+        save('searchFilter');
       }
     };
     searchEl.addEventListener('pointerdown', primeAudio, { once: true });
@@ -2296,7 +3125,7 @@ function wireHeaderInteractions(groups, sectionsWasOpen) {
       minBtn.dataset._done = '1';
       minimized = true;
       snoozeOpenRuntime = false;
-      save();
+      save('minimized');
       panel.classList.add('qm-hidden');
       if (minimizedBtn) minimizedBtn.style.display = 'block';
       setTimeout(() => { minBtn.dataset._done = ''; }, 300);
@@ -2312,7 +3141,7 @@ function wireHeaderInteractions(groups, sectionsWasOpen) {
     callsSel.onmousedown = () => { selectActiveRuntime = true; };
     callsSel.onchange = () => {
       sortCallsOrder = callsSel.value;
-      save();
+      save('sortCallsOrder');
     };
     callsSel.onblur = () => { selectActiveRuntime = false; };
   }
@@ -2322,21 +3151,22 @@ function wireHeaderInteractions(groups, sectionsWasOpen) {
     statusSel.onmousedown = () => { selectActiveRuntime = true; };
     statusSel.onchange = () => {
       sortStatusOrder = statusSel.value;
-      save();
+      save('sortStatusOrder');
     };
     statusSel.onblur = () => { selectActiveRuntime = false; };
   }
 
-  // Favoris
-  panel.querySelectorAll('button.qm-fav').forEach(btn => {
-    btn.onclick = e => {
-      const name = e.currentTarget.getAttribute('data-name');
-      if (favorites.has(name)) favorites.delete(name);
-      else favorites.add(name);
-      Storage.set('favorites', [...favorites]);
-      updateUI(groups);
-    };
-  });
+  // Favoris (délégué : les cartes vont et viennent)
+  const content = panel.querySelector('#panel-content');
+  if (content) {
+    content.addEventListener('click', e => {
+      const btn = e.target.closest('button.qm-fav');
+      if (!btn) return;
+      const name = btn.getAttribute('data-name');
+      setPref({ fav: name, on: !favorites.has(name) });
+      updateUI(lastRenderedGroups);
+    });
+  }
 }
 
 // Fin de la partie 4.
@@ -2371,7 +3201,14 @@ function isMenuOpen() {
 // ====== RESET COMPLET ======
 function doReset() {
   if (!confirm('Réinitialiser toutes les données (slots, timers, favoris, préférences) ?')) return;
+  if (!TabLeader.isLeader()) {
+    TabLeader.post({ type: 'reset' });
+    return;
+  }
+  resetAll();
+}
 
+function resetAll() {
   masterSlotList = [];
   connectedUsers = [];
   lastGroup = {};
@@ -2396,13 +3233,16 @@ function doReset() {
   muted = false;
   snoozeUntil = 0;
   historyByDay = {};
+  histPreviewCache.clear();
   dailyAgg = {};
   callAlerted = {};
   chatAlerted = {};
   prohibAlerted = {};
   activeAlerts = { total: 0 };
+  TimerWheel.resetAlerts();
 
   Storage.clear();
+  HistoryStore.clear();
   save();
   if (panel) panel.remove();
   panel = createPanel();
@@ -2423,15 +3263,304 @@ function debouncedProcessAgents() {
   }, CONFIG.MENU_DEBOUNCE);
 }
 
+// ====== MULTI-ONGLETS : UN SEUL LEADER ======
+// Le leader est le détenteur du verrou Web Locks (libéré par le navigateur à la
+// fermeture de l'onglet, insensible au bridage des timers en arrière-plan) ; sans
+// navigator.locks, élection par heartbeat BroadcastChannel, où l'identifiant le plus
+// petit garde la main. Seul le leader scrape, persiste et alerte ; il diffuse groupes
+// et timers aux suiveurs, qui ne font qu'afficher. Un leader masqué ou sans rapport
+// passe la main à un suiveur visible qui affiche des lignes (il ne scrape pas, sinon).
+const TAB_ID = Date.now().toString(36) + Math.random().toString(36).slice(2, 8);
+const LEADER_LOCK = CONFIG.STORAGE_PREFIX + 'leader';
+
+let tabChannel = null;
+let leaderId = null;
+let leaderSeenAt = 0;
+let leaderHidden = false;  // côté suiveur : dernier état annoncé par le leader
+let followerSeenAt = 0;   // côté leader : inutile de diffuser sans suiveur
+let followers = new Map(); // côté leader : id → { rows, hidden, at }
+let useLeaderLock = false;
+let leaderLockGen = 0;
+let leaderLockAbort = null; // demande en file, annulée avant un vol
+let followerGroups = null;
+let remotePreviews = {};  // côté suiveur : infobulles d'historique calculées par le leader
+
+// Agent sans référence DOM (clonable par postMessage)
+const agentDto = a => ({
+  id: a.id,
+  name: a.name,
+  status: a.status,
+  statusClass: a.statusClass,
+  activityCount: a.activityCount,
+  onQueue: a.onQueue,
+  channel: a.channel
+});
+
+class TabLeader {
+  static start() {
+    if (!('BroadcastChannel' in window)) {
+      this.promote();
+      return;
+    }
+    tabChannel = new BroadcastChannel(CONFIG.STORAGE_PREFIX + 'tabs');
+    tabChannel.onmessage = e => this.onMessage(e.data || {});
+    window.addEventListener('pagehide', () => {
+      if (isLeaderTab) this.post({ type: 'bye' });
+    });
+    // Changement de visibilité : annonce immédiate (les timers d'un onglet masqué sont bridés)
+    document.addEventListener('visibilitychange', () => this.heartbeat());
+    setInterval(() => this.heartbeat(), CONFIG.LEADER_HEARTBEAT_MS);
+    this.post({ type: 'hello' });
+
+    useLeaderLock = !!(navigator.locks && navigator.locks.request);
+    if (useLeaderLock) this.requestLock(false);
+    else setTimeout(() => this.heartbeat(), CONFIG.LEADER_ELECT_MS);
+  }
+
+  // Verrou accordé → leader jusqu'à fermeture de l'onglet ou vol par un suiveur désigné
+  static requestLock(steal) {
+    const gen = ++leaderLockGen;
+    if (leaderLockAbort) leaderLockAbort.abort();
+    leaderLockAbort = steal ? null : new AbortController();
+    const opts = steal ? { steal: true } : { signal: leaderLockAbort.signal };
+    navigator.locks.request(LEADER_LOCK, opts, () => {
+      if (gen === leaderLockGen) leaderLockAbort = null;
+      this.promote();
+      return new Promise(() => {}); // tenu tant que l'onglet vit
+    }).catch(() => {
+      if (gen !== leaderLockGen) return; // demande remplacée par un vol
+      // Verrou volé : on redevient suiveur et on se remet en file
+      if (isLeaderTab) this.demote();
+      this.requestLock(false);
+    });
+  }
+
+  // Onglet utile = visible avec des lignes de rapport (un onglet masqué ne scrape pas)
+  static canScrape(rows, hidden) {
+    return rows > 0 && !hidden;
+  }
+
+  static reportRows() {
+    return getAllDocs().reduce((n, doc) => n + qsa(doc, ROW_SELECTOR).length, 0);
+  }
+
+  static maybeHandOff() {
+    if (!isLeaderTab || this.canScrape(this.reportRows(), document.hidden)) return;
+    const now = Date.now();
+    let target = null;
+    followers.forEach((f, id) => {
+      if (now - f.at > CONFIG.LEADER_TIMEOUT_MS) followers.delete(id);
+      else if (!target && this.canScrape(f.rows, f.hidden)) target = id;
+    });
+    if (!target) return;
+    log.info('[QM] passage de main à ' + target);
+    followers.delete(target);
+    // Stockage à jour AVANT que la cible ne le relise (promote → reloadPersisted)
+    flush();
+    if (!useLeaderLock) {
+      leaderId = target;
+      leaderSeenAt = now;
+      this.demote();
+    }
+    // Avec verrou, on cède quand la cible le vole (elle peut avoir disparu d'ici là)
+    this.post({ type: 'handoff', to: target });
+  }
+
+  static isLeader() {
+    return isLeaderTab;
+  }
+
+  static post(msg) {
+    if (!tabChannel) return;
+    try {
+      tabChannel.postMessage(Object.assign({ from: TAB_ID }, msg));
+    } catch (e) {
+      log.error('BroadcastChannel', e);
+    }
+  }
+
+  static heartbeat() {
+    if (!tabChannel) return;
+    if (isLeaderTab) {
+      this.post({ type: 'hb', hidden: document.hidden });
+      this.maybeHandOff();
+      return;
+    }
+    const timeout = leaderHidden ? CONFIG.LEADER_HIDDEN_TIMEOUT_MS : CONFIG.LEADER_TIMEOUT_MS;
+    if (useLeaderLock || (leaderId && Date.now() - leaderSeenAt <= timeout)) {
+      this.post({ type: 'follow', rows: this.reportRows(), hidden: document.hidden });
+    } else {
+      this.promote();
+    }
+  }
+
+  static onMessage(msg) {
+    if (msg.from === TAB_ID) return;
+    switch (msg.type) {
+      case 'hello':
+        if (isLeaderTab) this.post({ type: 'hb', hidden: document.hidden });
+        break;
+      case 'hb':
+        // Avec verrou, deux leaders ne coexistent que le temps d'un vol : le volé cède seul
+        if (isLeaderTab && !useLeaderLock) {
+          if (msg.from > TAB_ID) return; // l'autre cèdera en recevant notre heartbeat
+          this.demote();
+        }
+        leaderId = msg.from;
+        leaderSeenAt = Date.now();
+        leaderHidden = !!msg.hidden;
+        break;
+      case 'follow':
+        followerSeenAt = Date.now();
+        followers.set(msg.from, { rows: msg.rows || 0, hidden: !!msg.hidden, at: followerSeenAt });
+        if (isLeaderTab) this.maybeHandOff();
+        break;
+      case 'handoff':
+        if (msg.to !== TAB_ID || isLeaderTab) break;
+        if (useLeaderLock) this.requestLock(true);
+        else this.promote();
+        break;
+      case 'bye':
+        followers.delete(msg.from);
+        if (msg.from !== leaderId) break;
+        leaderId = null;
+        leaderHidden = false;
+        // Petit délai aléatoire : le premier qui se déclare coupe l'herbe sous le pied des autres
+        setTimeout(() => { if (!leaderId) this.heartbeat(); }, Math.random() * 300);
+        break;
+      case 'state':
+        if (isLeaderTab) break;
+        leaderId = msg.from;
+        leaderSeenAt = Date.now();
+        this.applyState(msg);
+        break;
+      case 'pref':
+        if (isLeaderTab) this.applyPrefs(msg.ops || []);
+        break;
+      case 'reset':
+        if (isLeaderTab) resetAll();
+        break;
+    }
+  }
+
+  static promote() {
+    if (isLeaderTab) return;
+    isLeaderTab = true;
+    leaderId = TAB_ID;
+    this.post({ type: 'hb', hidden: document.hidden });
+    log.info('[QM] onglet leader (' + TAB_ID + ')');
+
+    // L'état local vient des diffusions de l'ancien leader : on repart du stockage,
+    // sauf disposition et recherche, propres à cet onglet
+    reloadPersisted(LOCAL_PREF_KEYS);
+    HistoryStore.reload();
+    RowScanner.reset();
+    HoverScheduler.reset();
+    followerGroups = null;
+    remotePreviews = {};
+    if (panel) processAgents();
+  }
+
+  static demote() {
+    flush();
+    HoverScheduler.cancel();
+    isLeaderTab = false;
+    log.info('[QM] onglet suiveur');
+  }
+
+  // Leader → suiveurs, après chaque processAgents
+  static publish(groups) {
+    if (!tabChannel || Date.now() - followerSeenAt > CONFIG.LEADER_TIMEOUT_MS) return;
+    const dto = {};
+    const previews = {};
+    Object.keys(groups).forEach(k => {
+      dto[k] = groups[k].map(a => {
+        if (!(a.name in previews)) previews[a.name] = histPreview(a.name);
+        return agentDto(a);
+      });
+    });
+    this.post({
+      type: 'state',
+      groups: dto,
+      previews,
+      masterSlotList,
+      connectedUsers,
+      statusStartAt,
+      callStartAt,
+      chatStartAt,
+      lastInCall,
+      lastInChat,
+      activeAlerts,
+      // Alertes déjà tirées : un suiveur promu ne doit pas les rejouer
+      alerted: { call: callAlerted, chat: chatAlerted, prohib: prohibAlerted },
+      prefs: Object.fromEntries(PREF_KEYS.map(k => [k, PERSISTED[k]()]))
+    });
+  }
+
+  static applyState(msg) {
+    masterSlotList = msg.masterSlotList || [];
+    connectedUsers = msg.connectedUsers || [];
+    statusStartAt = msg.statusStartAt || {};
+    callStartAt = msg.callStartAt || {};
+    chatStartAt = msg.chatStartAt || {};
+    lastInCall = msg.lastInCall || {};
+    lastInChat = msg.lastInChat || {};
+    activeAlerts = msg.activeAlerts || { total: 0 };
+    const alerted = msg.alerted || {};
+    callAlerted = alerted.call || {};
+    chatAlerted = alerted.chat || {};
+    prohibAlerted = alerted.prohib || {};
+    // Préférences partagées : la version du leader fait foi (deltas déjà appliqués)
+    const prefs = msg.prefs || {};
+    Object.keys(prefs).filter(k => PREF_KEYS.includes(k)).forEach(k => PERSISTED_SET[k](prefs[k]));
+    remotePreviews = msg.previews || {};
+    followerGroups = msg.groups || {};
+    if (panel && !isMenuOpen() && !isQmUiBusy()) updateUI(this.followerView());
+  }
+
+  // Groupes du leader filtrés par la recherche de CET onglet (préférence locale)
+  static followerView() {
+    if (!searchFilter || !followerGroups) return followerGroups;
+    const f = norm(searchFilter);
+    const out = {};
+    Object.keys(followerGroups).forEach(k => {
+      out[k] = followerGroups[k].filter(a => norm(a.name).includes(f));
+    });
+    return out;
+  }
+
+  // Suiveur → leader : seules les modifications de préférences partagées partent
+  static forwardPrefs(ops) {
+    if (ops.length) this.post({ type: 'pref', ops });
+  }
+
+  // Leader : applique, persiste, puis re-tri et rediffusion immédiats (processAgents
+  // → publish) pour que tous les onglets convergent sans attendre le tick
+  static applyPrefs(ops) {
+    const keys = [...new Set(ops.map(applyPrefOp).filter(Boolean))];
+    if (!keys.length) return;
+    save(...keys);
+    if (panel) processAgents();
+  }
+}
+
 // ====== COEUR: PROCESS AGENTS (RAPPORT UNIQUEMENT) ======
 function processAgents() {
   try {
+    if (!isLeaderTab) {
+      // Suiveur : on ré-affiche la dernière diffusion du leader
+      if (followerGroups && !isMenuOpen() && !isQmUiBusy()) updateUI(TabLeader.followerView());
+      return;
+    }
+
     if (isMenuOpen() || isQmUiBusy()) {
       debouncedProcessAgents();
       return;
     }
 
+    selectorCalls = 0;
     const agentsRaw = findAgentsInReportOnly(); // <- UNIQUEMENT le rapport
+    HoverScheduler.plan(agentsRaw);
     let agents = agentsRaw;
 
     if (searchFilter) {
@@ -2445,9 +3574,15 @@ function processAgents() {
         // Timers & statuts pour chaque agent
     agents.forEach(agent => {
   const key = deriveStatusKey(agent);
-  ensureStatusTimerOnly(key, agent.name);
+  ensureStatusTimerOnly(key, agent.name, agent.status);
+  // Durées Genesys relues seulement pour une ligne re-parsée (nouvel enregistrement,
+  // donc balayage complet compris) ou si la section a changé : entre deux, les
+  // timers locaux avancent seuls et une dérive < 5 s est ignorée de toute façon.
+  const reread = !agent.durations || agent.durations.key !== key;
+  if (reread) agent.durations = { key, task: null, chats: null };
+  const dur = agent.durations;
     // Aligne le timer de statut pour TOUS les statuts sur la durée affichée par Genesys
-{
+if (reread) {
   const stSec = extractStatusDurationFromRow(agent.rowElement);
   if (stSec != null) {
     const desiredMs = stSec * 1000;
@@ -2467,14 +3602,15 @@ function processAgents() {
     // Cas particulier : "Tâche associée" avec un appel en cours
     // → on regarde la colonne "Durée" des appels (.time-duration) s'il y a une icône téléphone
     if (!inCall && key === 'tache') {
-      const tacheSec = extractTaskCallDurationFromRow(agent.rowElement);
-      if (tacheSec != null && tacheSec > 0) {
+      const tacheSec = reread ? extractTaskCallDurationFromRow(agent.rowElement) : null;
+      if (reread) dur.task = tacheSec != null && tacheSec > 0;
+      if (dur.task) {
         inCall = true;
         genesysSec = tacheSec;
       }
     }
 
-    if (inCall && genesysSec == null) {
+    if (reread && inCall && genesysSec == null) {
       // On essaie de resynchroniser avec la durée d'interaction affichée dans le rapport
       genesysSec = extractCallDurationFromRow(agent.rowElement);
     }
@@ -2487,9 +3623,12 @@ function processAgents() {
 let chatCount = 0;
 let chatDurSecs = [];
 if (key === 'en_chat') {
-  chatDurSecs = extractChatDurationsFromAgentRow(agent.rowElement) || [];
-  if (chatDurSecs.length) {
-    chatCount = Math.min(2, chatDurSecs.length);
+  if (reread) {
+    chatDurSecs = extractChatDurationsFromAgentRow(agent.rowElement) || [];
+    dur.chats = chatDurSecs.length;
+  }
+  if (dur.chats) {
+    chatCount = Math.min(2, dur.chats);
   } else {
     const explicitCnt = (agent.channel && agent.channel.chatCount) || 1;
     chatCount = CONFIG.SHOW_CHAT_MULTIPLIER ? clamp(explicitCnt, 1, 5) : 1;
@@ -2519,7 +3658,7 @@ if (chatDurSecs.length) {
 });
 
 
-    save();
+    save('lastGroup', 'statusStartAt', 'chatStartAt', 'lastInChat', 'chatOffStreak');
 
     // Construction des groupes par slot
     const bySlot = ConnectedUsersManager.getConnectedBySlot();
@@ -2605,13 +3744,13 @@ Object.keys(groups).forEach(k => {
       seen.add(a.name);
       const key = deriveStatusKey(a);
 
-      // Prohibé
+      // Les sons/notifs partent de TimerWheel à l'échéance ; ici on compte et on arme.
+
+      // Prohibé (échéance immédiate)
       if (key === 'prohib') {
         activeAlerts.total++;
         if (!prohibAlerted[a.name]) {
-          prohibAlerted[a.name] = true;
-          beep(520, 200);
-          notify('Statut prohibé', a.name + ' en ' + (prohibSubtypeFromStatus(a.status || '') || 'prohibé'));
+          TimerWheel.arm('prohib', a.name, statusStartAt[a.name], 0, { sub: prohibSubtypeFromStatus(a.status || '') });
         }
       } else {
         prohibAlerted[a.name] = false;
@@ -2622,14 +3761,12 @@ Object.keys(groups).forEach(k => {
         const ms = msSince(callStartAt[a.name]);
         if (ms >= CONFIG.CALL_ALERT_SECS * 1000) {
           activeAlerts.total++;
-          if (!callAlerted[a.name]) {
-            callAlerted[a.name] = true;
-            beep(880, 200);
-            notify('Appel long', a.name + ' 📞 ' + toHMS(ms));
-          }
         } else {
           callAlerted[a.name] = false;
         }
+        if (!callAlerted[a.name]) {
+          TimerWheel.arm('call', a.name, callStartAt[a.name], CONFIG.CALL_ALERT_SECS * 1000);
+        }
       } else {
         callAlerted[a.name] = false;
       }
@@ -2639,19 +3776,20 @@ Object.keys(groups).forEach(k => {
         const ms = msSince(chatStartAt[a.name][0]);
         if (ms >= CONFIG.CHAT_ALERT_SECS * 1000) {
           activeAlerts.total++;
-          if (!chatAlerted[a.name]) {
-            chatAlerted[a.name] = true;
-            beep(700, 200);
-            notify('Chat long', a.name + ' 💬 ' + toHMS(ms));
-          }
         } else {
           chatAlerted[a.name] = false;
         }
+        if (!chatAlerted[a.name]) {
+          TimerWheel.arm('chat', a.name, chatStartAt[a.name][0], CONFIG.CHAT_ALERT_SECS * 1000);
+        }
       } else {
         chatAlerted[a.name] = false;
       }
     });
+    TimerWheel.drainAlerts(Date.now());
 
+    scanStats.selectorCalls = selectorCalls;
+    TabLeader.publish(groups);
     updateUI(groups);
   } catch (e) {
     console.error('[QM ERROR] processAgents', e);
@@ -2664,10 +3802,22 @@ Object.keys(groups).forEach(k => {
 }
 
 // ====== OBSERVERS ======
+const REPORT_OBSERVER_OPTIONS = {
+  childList: true,
+  subtree: true,
+  characterData: true,
+  attributes: true,
+  attributeFilter: ['class', 'style', 'aria-label', 'aria-expanded', 'data-state']
+};
+
+let reportObserver = null;
+
 function setupObservers() {
   try {
-    const obs = new MutationObserver(muts => {
+    reportObserver = new MutationObserver(muts => {
+      if (!isLeaderTab) return;
       let need = false;
+      for (const m of muts) RowScanner.markMutation(m);
       for (const m of muts) {
         if (m.type === 'childList') {
           if ([...m.addedNodes, ...m.removedNodes].some(
@@ -2694,51 +3844,85 @@ function setupObservers() {
       }
     });
 
-    obs.observe(document.body, {
-      childList: true,
-      subtree: true,
-      attributes: true,
-      attributeFilter: ['class', 'style', 'aria-label', 'aria-expanded', 'data-state']
-    });
+    RowScanner.observeDoc(document);
   } catch (e) {
     console.error('[QM ERROR] setupObservers', e);
   }
 }
 
-// ====== VISUAL TICK (timers UI) ======
+// ====== ROUE DE TEMPS (timers UI, tâches périodiques, échéances d'alerte) ======
+// Un seul planificateur : calé sur la seconde pleine puis requestAnimationFrame,
+// suspendu tant que l'onglet est caché. Les .qm-timer sont mis en cache avec leur
+// début en epoch ms ; seul le texte qui change est réécrit. Les alertes longues
+// sont posées dans un tas binaire et tirées à leur échéance, sans sondage.
+
+const TIMER_ICONS = { call: '📞', chat: '💬', status: '⏳' };
+
+let timerEntries = null; // null = liste à reconstruire (cartes créées/supprimées)
+let wheelTasks   = new Map(); // id → { everyMs, fn, nextAt }
+let wheelTimeout = null;
+let wheelFrame   = null;
+let alertHeap    = []; // tas min sur .at : { at, kind, name, start }
+let alertArmed   = new Map(); // kind:name → start armé (évite les doublons)
+let wheelStats   = { frames: 0, textWrites: 0, alertsFired: 0 };
+
+// Source ISO courante d'un timer (null = timer inactif)
+function timerSourceIso(t) {
+  if (t.type === 'call') return callStartAt[t.name] || null;
+  if (t.type === 'chat') {
+    const arr = chatStartAt[t.name];
+    return (Array.isArray(arr) && t.idx != null && arr[t.idx]) || null;
+  }
+  if (t.type === 'status') return statusStartAt[t.name] || null;
+  return null;
+}
+
+function buildTimerEntries() {
+  if (!panel) return [];
+  return Array.from(panel.querySelectorAll('.qm-timer')).map(el => {
+    const idxAttr = el.getAttribute('data-idx');
+    return {
+      el,
+      name: el.getAttribute('data-name'),
+      type: el.getAttribute('data-type'),
+      idx: idxAttr != null ? parseInt(idxAttr, 10) : null,
+      card: el.closest('.qm-card'),
+      iso: null,
+      startMs: 0,
+      text: el.textContent,
+      pulse: null
+    };
+  });
+}
+
 function visualTick() {
   try {
-    document.querySelectorAll('#queue-monitor-panel .qm-timer').forEach(el => {
-      const name = el.getAttribute('data-name');
-      const type = el.getAttribute('data-type');
-      const idxAttr = el.getAttribute('data-idx');
-      const idx = idxAttr != null ? parseInt(idxAttr, 10) : null;
-
-      let ms = 0;
-      let icon = '⏳';
-
-      if (!name) return;
-
-      if (type === 'call' && callStartAt[name]) {
-        ms = msSince(callStartAt[name]);
-        icon = '📞';
-      } else if (type === 'chat' && Array.isArray(chatStartAt[name]) && idx != null && chatStartAt[name][idx]) {
-        ms = msSince(chatStartAt[name][idx]);
-        icon = '💬';
-      } else if (type === 'status' && statusStartAt[name]) {
-        ms = msSince(statusStartAt[name]);
-        icon = '⏳';
-      } else {
-        return;
+    if (!timerEntries || timerEntries.some(t => !t.el.isConnected)) {
+      timerEntries = buildTimerEntries();
+    }
+    const now = Date.now();
+    timerEntries.forEach(t => {
+      if (!t.name) return;
+      const iso = timerSourceIso(t);
+      if (!iso) return;
+      if (iso !== t.iso) {
+        t.iso = iso;
+        t.startMs = new Date(iso).getTime();
       }
 
-      el.textContent = icon + ' ' + toHMS(ms);
+      const ms = now - t.startMs;
+      const text = TIMER_ICONS[t.type] + ' ' + toHMS(ms);
+      if (text !== t.text) {
+        t.el.textContent = text;
+        t.text = text;
+        wheelStats.textWrites++;
+      }
 
-      if (type === 'call') {
-        const card = el.closest('.qm-card');
-        if (card) {
-          if (ms >= CONFIG.CALL_ALERT_SECS * 1000) card.classList.add('qm-pulse');
-          else card.classList.remove('qm-pulse');
+      if (t.type === 'call' && t.card) {
+        const pulse = ms >= CONFIG.CALL_ALERT_SECS * 1000;
+        if (pulse !== t.pulse) {
+          t.card.classList.toggle('qm-pulse', pulse);
+          t.pulse = pulse;
         }
       }
     });
@@ -2747,6 +3931,159 @@ function visualTick() {
   }
 }
 
+// --- Tas binaire des échéances d'alerte ---
+function heapPush(item) {
+  alertHeap.push(item);
+  let i = alertHeap.length - 1;
+  while (i > 0) {
+    const p = (i - 1) >> 1;
+    if (alertHeap[p].at <= alertHeap[i].at) break;
+    [alertHeap[p], alertHeap[i]] = [alertHeap[i], alertHeap[p]];
+    i = p;
+  }
+}
+
+function heapPop() {
+  const top = alertHeap[0];
+  const last = alertHeap.pop();
+  if (alertHeap.length) {
+    alertHeap[0] = last;
+    let i = 0;
+    for (;;) {
+      const l = 2 * i + 1;
+      const r = l + 1;
+      let m = i;
+      if (l < alertHeap.length && alertHeap[l].at < alertHeap[m].at) m = l;
+      if (r < alertHeap.length && alertHeap[r].at < alertHeap[m].at) m = r;
+      if (m === i) break;
+      [alertHeap[m], alertHeap[i]] = [alertHeap[i], alertHeap[m]];
+      i = m;
+    }
+  }
+  return top;
+}
+
+// L'état a-t-il changé depuis l'armement ? (appel raccroché, nouveau statut…)
+function alertStillDue(a) {
+  if (a.kind === 'call') {
+    return !!lastInCall[a.name] && callStartAt[a.name] === a.start && !callAlerted[a.name];
+  }
+  if (a.kind === 'chat') {
+    const arr = chatStartAt[a.name];
+    return !!lastInChat[a.name] && Array.isArray(arr) && arr[0] === a.start && !chatAlerted[a.name];
+  }
+  if (a.kind === 'prohib') {
+    return lastStatusKey[a.name] === 'prohib' && statusStartAt[a.name] === a.start && !prohibAlerted[a.name];
+  }
+  return false;
+}
+
+function fireAlert(a) {
+  wheelStats.alertsFired++;
+  if (a.kind === 'call') {
+    callAlerted[a.name] = true;
+    beep(880, 200);
+    notify('Appel long', a.name + ' 📞 ' + toHMS(msSince(a.start)));
+  } else if (a.kind === 'chat') {
+    chatAlerted[a.name] = true;
+    beep(700, 200);
+    notify('Chat long', a.name + ' 💬 ' + toHMS(msSince(a.start)));
+  } else if (a.kind === 'prohib') {
+    prohibAlerted[a.name] = true;
+    beep(520, 200);
+    notify('Statut prohibé', a.name + ' en ' + (a.sub || 'prohibé'));
+  }
+}
+
+class TimerWheel {
+  static start() {
+    document.addEventListener('visibilitychange', () => {
+      if (document.hidden) this.stop();
+      else this.schedule();
+    });
+    this.schedule();
+  }
+
+  static stop() {
+    clearTimeout(wheelTimeout);
+    if (wheelFrame != null) cancelAnimationFrame(wheelFrame);
+    wheelTimeout = null;
+    wheelFrame = null;
+  }
+
+  // Prochain réveil : seconde pleine suivante, ou échéance d'alerte si plus proche
+  static schedule() {
+    if (document.hidden || wheelTimeout != null || wheelFrame != null) return;
+    const now = Date.now();
+    let wait = CONFIG.TICK_INTERVAL - (now % CONFIG.TICK_INTERVAL);
+    if (alertHeap.length) wait = Math.min(wait, Math.max(0, alertHeap[0].at - now));
+    wheelTimeout = setTimeout(() => {
+      wheelTimeout = null;
+      wheelFrame = requestAnimationFrame(() => {
+        wheelFrame = null;
+        this.turn();
+      });
+    }, wait);
+  }
+
+  static turn() {
+    if (document.hidden) return;
+    wheelStats.frames++;
+    const now = Date.now();
+
+    this.drainAlerts(now);
+    visualTick();
+    wheelTasks.forEach(task => {
+      if (now < task.nextAt) return;
+      task.nextAt = now + task.everyMs;
+      try { task.fn(); } catch (e) { console.error('[QM ERROR] wheel task', e); }
+    });
+
+    this.schedule();
+  }
+
+  static drainAlerts(now) {
+    while (alertHeap.length && alertHeap[0].at <= now) {
+      const a = heapPop();
+      alertArmed.delete(a.kind + ':' + a.name);
+      if (isLeaderTab && alertStillDue(a)) fireAlert(a);
+    }
+  }
+
+  // Échéance absolue : start (ISO) + delayMs. Déjà dépassée → tirée au prochain tour.
+  // extra : données figées à l'armement et relues par fireAlert (ex. sous-type prohibé)
+  static arm(kind, name, start, delayMs, extra) {
+    if (!start) return;
+    const k = kind + ':' + name;
+    if (alertArmed.get(k) === start) return;
+    alertArmed.set(k, start);
+    heapPush(Object.assign({ at: new Date(start).getTime() + delayMs, kind, name, start }, extra));
+    // Le réveil déjà posé peut être plus tardif que cette échéance
+    if (wheelTimeout != null) {
+      clearTimeout(wheelTimeout);
+      wheelTimeout = null;
+    }
+    this.schedule();
+  }
+
+  static every(id, everyMs, fn) {
+    wheelTasks.set(id, { everyMs, fn, nextAt: Date.now() + everyMs });
+  }
+
+  static remove(id) {
+    wheelTasks.delete(id);
+  }
+
+  static invalidate() {
+    timerEntries = null;
+  }
+
+  static resetAlerts() {
+    alertHeap = [];
+    alertArmed = new Map();
+  }
+}
+
 // ====== HOTKEYS & WATCHDOG ======
 function hotkeys(e) {
   if (!(e.shiftKey && e.altKey)) return;
@@ -2754,15 +4091,21 @@ function hotkeys(e) {
     minimized = false;
     panelPos = null;
     panelSize = null;
-    save();
+    save('minimized', 'panelPos', 'panelSize');
     if (panel) panel.remove();
     createPanel();
     processAgents();
     if (minimizedBtn) minimizedBtn.style.display = 'none';
   } else if (e.code === 'KeyR') {
     if (confirm('Queue Monitor – Reset complet ?')) {
+      if (!isLeaderTab) {
+        TabLeader.post({ type: 'reset' });
+        location.reload();
+        return;
+      }
+      persistFrozen = true;
       Storage.clear();
-      location.reload();
+      HistoryStore.clear().then(() => location.reload());
     }
   }
 }
@@ -2810,10 +4153,11 @@ function init() {
   injectUiFixStyles();
   injectThemeStyles();
 
+  TabLeader.start();
   setupObservers();
   scheduleLogicLoop();
-  setInterval(visualTick, CONFIG.TICK_INTERVAL);
-  setTimeout(startHoverSimulation, 3000);
+  TimerWheel.start();
+  HoverScheduler.start();
 
   setTimeout(() => {
     if (!isMenuOpen() && !isQmUiBusy()) processAgents();
@@ -2845,7 +4189,13 @@ function init() {
       muted,
       snoozeUntil,
       dailyAgg,
-      historyByDay
+      historyByDay,
+      scanStats,
+      uiStats,
+      classifier: Object.assign({ distinct: statusMemo.size }, classifierStats),
+      hoverStats,
+      wheelStats,
+      tab: { id: TAB_ID, leader: isLeaderTab, leaderId }
     })
   };
 
@@ -2856,7 +4206,7 @@ function init() {
         w: Math.max(r.width, CONFIG.PANEL_MIN_W),
         h: Math.max(r.height, CONFIG.PANEL_MIN_H)
       };
-      save();
+      save('panelSize');
     }
   });
   ro.observe(panel);
@@ -2874,8 +4224,43 @@ function init() {
   log.info('[QM] running (report-only, slots + timers + alertes actifs)');
 }
 
+// ====== BANC D'ESSAI (bench/run.js, Node + jsdom) ======
+// window.__QM_BENCH__ posé avant l'injection → pas d'init() (ni timers, ni leader) :
+// on expose les étages du pipeline pour les mesurer sur des fixtures hors Genesys.
+function exposeBench(bench) {
+  Object.assign(bench, {
+    variant: 'v2.0',
+    setup() {
+      isLeaderTab = true;
+      panel = createPanel();
+      HistoryStore.load();
+      // Observer réduit au marquage des lignes : aucun processAgents différé pendant la mesure
+      reportObserver = new MutationObserver(muts => muts.forEach(m => RowScanner.markMutation(m)));
+      RowScanner.observeDoc(document);
+    },
+    findAgents() {
+      selectorCalls = 0;
+      return findAgentsInReportOnly();
+    },
+    deriveStatusKey,
+    detectChannel: detectChannelFromRow,
+    durations: {
+      call: extractCallDurationFromRow,
+      taskCall: extractTaskCallDurationFromRow,
+      chat: extractChatDurationsFromAgentRow,
+      status: extractStatusDurationFromRow
+    },
+    processAgents,
+    updateUI,
+    groups: () => lastRenderedGroups,
+    stats: () => ({ scan: scanStats, ui: uiStats, selectorCalls })
+  });
+}
+
 // ====== INIT LANCEMENT ======
-if (document.readyState === 'loading') {
+if (window.__QM_BENCH__) {
+  exposeBench(window.__QM_BENCH__);
+} else if (document.readyState === 'loading') {
   document.addEventListener('DOMContentLoaded', init);
 } else {
   setTimeout(init, 300);
@@ -0,0 +1,290 @@
+'use strict';
+
+// Fixtures synthétiques du rapport d'activité (v2.0) et du widget AGENT_STATUS (v2.1).
+// Un même roster (généré à partir d'une graine) est rendu dans les deux DOM, puis
+// rejoué avec la même séquence de mutations : les deux variantes sont comparables.
+
+const FIRST = [
+  'Camille', 'Léa', 'Hugo', 'Lucas', 'Chloé', 'Inès', 'Nathan', 'Manon', 'Théo', 'Sarah',
+  'Yanis', 'Jade', 'Louis', 'Zoé', 'Adam', 'Emma', 'Noah', 'Lina', 'Rayan', 'Anaïs'
+];
+const LAST = [
+  'Martin', 'Bernard', 'Dubois', 'Thomas', 'Robert', 'Richard', 'Petit', 'Durand', 'Leroy', 'Moreau',
+  'Simon', 'Laurent', 'Lefèvre', 'Michel', 'Garcia', 'David', 'Bertrand', 'Roux', 'Vincent', 'Fournier',
+  'Morel', 'Girard', 'André', 'Mercier', 'Dupont', 'Lambert', 'Bonnet', 'François', 'Martinez', 'Legrand',
+  'Garnier', 'Faure', 'Rousseau', 'Blanc', 'Guérin', 'Muller', 'Henry', 'Roussel', 'Nicolas', 'Perrin',
+  'Morin', 'Mathieu', 'Clément', 'Gauthier', 'Dumont', 'Lopez', 'Fontaine', 'Chevalier', 'Robin', 'Masson'
+];
+
+// Libellés FR tels qu'affichés par Genesys, avec la classe du rond et le média éventuel
+const STATUSES = [
+  { text: 'En file d\'attente',      presence: 'on_queue',    weight: 6 },
+  { text: 'En cours d\'interaction', presence: 'interacting', weight: 6, media: 'call' },
+  { text: 'En cours d\'interaction', presence: 'interacting', weight: 2, media: 'chat' },
+  { text: 'Disponible',              presence: 'available',   weight: 2 },
+  { text: 'Pause',                   presence: 'away',        weight: 2 },
+  { text: 'Repas',                   presence: 'away',        weight: 1 },
+  { text: 'Réunion',                 presence: 'busy',        weight: 1 },
+  { text: 'Formation',               presence: 'busy',        weight: 1 },
+  { text: 'Occupé',                  presence: 'busy',        weight: 1 },
+  { text: 'Tâche associée',          presence: 'busy',        weight: 1, media: 'call' },
+  { text: 'Sans réponse',            presence: 'away',        weight: 1 },
+  { text: 'Travail après appel',     presence: 'busy',        weight: 1 },
+  { text: 'Non occupé',              presence: 'on_queue',    weight: 1 },
+  { text: 'Hors ligne',              presence: 'offline',     weight: 1 }
+];
+
+// PRNG déterministe (mulberry32)
+function rng(seed) {
+  let a = seed >>> 0;
+  return () => {
+    a = (a + 0x6D2B79F5) >>> 0;
+    let t = a;
+    t = Math.imul(t ^ (t >>> 15), t | 1);
+    t ^= t + Math.imul(t ^ (t >>> 7), t | 61);
+    return ((t ^ (t >>> 14)) >>> 0) / 4294967296;
+  };
+}
+
+function pickStatus(rand) {
+  const total = STATUSES.reduce((acc, s) => acc + s.weight, 0);
+  let r = rand() * total;
+  for (const s of STATUSES) {
+    r -= s.weight;
+    if (r < 0) return s;
+  }
+  return STATUSES[0];
+}
+
+function agentName(i) {
+  const base = FIRST[i % FIRST.length] + ' ' + LAST[Math.floor(i / FIRST.length) % LAST.length];
+  const round = Math.floor(i / (FIRST.length * LAST.length));
+  return round ? base + ' ' + (round + 1) : base;
+}
+
+function setStatus(agent, st, rand) {
+  agent.status = st.text;
+  agent.presence = st.presence;
+  agent.media = st.media || 'none';
+  agent.statusSec = Math.floor(rand() * 1800);
+  agent.callSec = agent.media === 'call' ? Math.floor(rand() * 900) : 0;
+  agent.chats = agent.media === 'chat'
+    ? Array.from({ length: 1 + Math.floor(rand() * 2) }, () => Math.floor(rand() * 1200))
+    : [];
+}
+
+function makeAgent(i, rand) {
+  const agent = { id: 'a' + i, name: agentName(i) };
+  setStatus(agent, pickStatus(rand), rand);
+  return agent;
+}
+
+function makeRoster(n, seed) {
+  const rand = rng(seed);
+  return Array.from({ length: n }, (_, i) => makeAgent(i, rand));
+}
+
+// --- Formats d'affichage Genesys ---
+const pad = n => String(n).padStart(2, '0');
+const hms = s => pad(Math.floor(s / 3600)) + ':' + pad(Math.floor(s / 60) % 60) + ':' + pad(s % 60);
+const ms = s => pad(Math.floor(s / 60)) + ':' + pad(s % 60);
+const verbose = s => (s >= 3600 ? Math.floor(s / 3600) + 'h ' : '') + (Math.floor(s / 60) % 60) + 'm ' + (s % 60) + 's';
+const esc = s => s.replace(/[&<>"]/g, c => ({ '&': '&amp;', '<': '&lt;', '>': '&gt;', '"': '&quot;' }[c]));
+
+// ===================== RAPPORT D'ACTIVITÉ (v2.0) =====================
+function reportInteractionsHtml(a) {
+  return a.media === 'call'
+    ? '<gux-icon icon-name="phone"></gux-icon><span class="time-duration">' + hms(a.callSec) + '</span>'
+    : '';
+}
+
+function reportRowHtml(a) {
+  return (
+    '<div class="dt-row" role="row" data-agent-id="' + a.id + '">' +
+      '<div class="dt-cell agentName"><div class="dt-cell-value">' +
+        '<a href="#/person/' + a.id + '">' + esc(a.name) + '</a>' +
+      '</div></div>' +
+      '<div class="dt-cell status status-picker">' +
+        '<div class="presenceIndicator"><span class="entity-v3-presence-indicator-dot presence-' + a.presence + '"></span></div>' +
+        '<div class="dt-cell-value">' + esc(a.status) + '</div>' +
+      '</div>' +
+      '<div class="dt-cell statusTime"><span class="unescaped-html-cell">' + verbose(a.statusSec) + '</span></div>' +
+      '<div class="dt-cell interactions">' + reportInteractionsHtml(a) + '</div>' +
+    '</div>' +
+    a.chats.map(sec =>
+      '<div class="dt-row dt-subrow" role="row" data-parent-id="' + a.id + '">' +
+        '<div class="dt-cell"><gux-icon icon-name="chat"></gux-icon><span class="time-duration">' + ms(sec) + '</span></div>' +
+      '</div>'
+    ).join('')
+  );
+}
+
+function miniCardHtml(a) {
+  const count = a.media === 'chat' ? a.chats.length : (a.media === 'call' ? 1 : 0);
+  return (
+    '<div class="entity-v3-mini-card" data-agent-id="' + a.id + '">' +
+      '<div class="name-header">' + esc(a.name) + '</div>' +
+      '<span class="entity-v3-activity-indicator' + (count ? ' has-activity' : '') + '">' + (count || '') + '</span>' +
+    '</div>'
+  );
+}
+
+function renderReport(doc, roster) {
+  doc.body.innerHTML =
+    '<div class="dt-table" role="grid">' + roster.map(reportRowHtml).join('') + '</div>' +
+    '<div class="popover-host">' + roster.map(miniCardHtml).join('') + '</div>';
+}
+
+// ===================== WIDGET AGENT_STATUS (v2.1) =====================
+function widgetTimeSec(a) {
+  return a.media === 'call' ? a.callSec : (a.media === 'chat' ? a.chats[0] : a.statusSec);
+}
+
+function widgetRowHtml(a) {
+  return (
+    '<tr data-row-id="' + a.id + '">' +
+      '<td class="column-agent"><a href="#/person/' + a.id + '">' + esc(a.name) + '</a></td>' +
+      '<td class="column-statusAndPresence">' +
+        '<span class="entity-v3-presence-indicator-dot presence-' + a.presence + '"></span>' +
+        '<span class="additional-label">' + esc(a.status) + '</span>' +
+      '</td>' +
+      '<td class="column-unifiedDuration"><span class="time-in-status">' + verbose(widgetTimeSec(a)) + '</span></td>' +
+    '</tr>'
+  );
+}
+
+function renderWidget(doc, roster) {
+  doc.body.innerHTML =
+    '<div class="widget-type-AGENT_STATUS"><table><tbody>' +
+      roster.map(widgetRowHtml).join('') +
+    '</tbody></table></div>';
+}
+
+// ===================== REJEU DE MUTATIONS =====================
+// Séquence pré-calculée (indépendante de la variante) :
+//  - chaque pas fait avancer toutes les durées d'une seconde (le bruit réel du rapport) ;
+//  - tous les 5 pas, ~5 % des agents changent de statut ;
+//  - tous les 10 pas, ~1 % des agents se déconnectent et autant se connectent.
+function makeReplay(roster, steps, seed) {
+  const rand = rng(seed ^ 0x9E3779B9);
+  const live = roster.map(a => a.id);
+  let nextIndex = roster.length;
+  const out = [];
+
+  for (let i = 1; i <= steps; i++) {
+    const ops = [{ type: 'tick' }];
+    if (i % 5 === 0) {
+      const k = Math.max(1, Math.round(live.length * 0.05));
+      for (let j = 0; j < k; j++) {
+        const id = live[Math.floor(rand() * live.length)];
+        const next = {};
+        setStatus(next, pickStatus(rand), rand);
+        ops.push({ type: 'status', id, next });
+      }
+    }
+    if (i % 10 === 0) {
+      const k = Math.max(1, Math.round(live.length * 0.01));
+      for (let j = 0; j < k; j++) {
+        const id = live.splice(Math.floor(rand() * live.length), 1)[0];
+        ops.push({ type: 'leave', id });
+        const agent = makeAgent(nextIndex++, rand);
+        live.push(agent.id);
+        ops.push({ type: 'join', agent });
+      }
+    }
+    out.push({ step: i, ops });
+  }
+  return out;
+}
+
+// Contexte de rejeu : roster vivant + rendu, muté en place comme le ferait Genesys
+function createReplayContext(doc, variant, roster) {
+  const agents = new Map(roster.map(a => [a.id, JSON.parse(JSON.stringify(a))]));
+  if (variant === 'v2.1') renderWidget(doc, [...agents.values()]);
+  else renderReport(doc, [...agents.values()]);
+  return { doc, variant, agents };
+}
+
+function rowOf(ctx, id) {
+  return ctx.variant === 'v2.1'
+    ? ctx.doc.querySelector('tr[data-row-id="' + id + '"]')
+    : ctx.doc.querySelector('.dt-row[data-agent-id="' + id + '"]');
+}
+
+function setTextIfChanged(el, text) {
+  if (el && el.textContent !== text) el.textContent = text;
+}
+
+function patchRow(ctx, a) {
+  const row = rowOf(ctx, a.id);
+  if (!row) return;
+  const dot = row.querySelector('.entity-v3-presence-indicator-dot');
+  const dotClass = 'entity-v3-presence-indicator-dot presence-' + a.presence;
+  if (dot && dot.className !== dotClass) dot.className = dotClass;
+
+  if (ctx.variant === 'v2.1') {
+    setTextIfChanged(row.querySelector('.additional-label'), a.status);
+    setTextIfChanged(row.querySelector('.time-in-status'), verbose(widgetTimeSec(a)));
+    return;
+  }
+
+  setTextIfChanged(row.querySelector('.status .dt-cell-value'), a.status);
+  setTextIfChanged(row.querySelector('.unescaped-html-cell'), verbose(a.statusSec));
+  const inter = row.querySelector('.interactions');
+  const callDur = inter.querySelector('.time-duration');
+  if (a.media === 'call' && callDur) setTextIfChanged(callDur, hms(a.callSec));
+  else if (inter.innerHTML !== reportInteractionsHtml(a)) inter.innerHTML = reportInteractionsHtml(a);
+
+  let sub = row.nextElementSibling;
+  a.chats.forEach(sec => {
+    if (!sub || sub.getAttribute('data-parent-id') !== a.id) return;
+    setTextIfChanged(sub.querySelector('.time-duration'), ms(sec));
+    sub = sub.nextElementSibling;
+  });
+}
+
+function applyStep(ctx, step) {
+  const { doc } = ctx;
+  step.ops.forEach(op => {
+    if (op.type === 'tick') {
+      ctx.agents.forEach(a => {
+        a.statusSec++;
+        if (a.media === 'call') a.callSec++;
+        a.chats = a.chats.map(s => s + 1);
+        patchRow(ctx, a);
+      });
+    } else if (op.type === 'status') {
+      const a = ctx.agents.get(op.id);
+      if (!a) return;
+      // Le média (et donc les sous-lignes de chat) reste celui du rendu initial
+      const media = a.media;
+      Object.assign(a, op.next, { media, chats: a.chats, callSec: media === 'call' ? op.next.callSec : 0 });
+      patchRow(ctx, a);
+    } else if (op.type === 'leave') {
+      ctx.agents.delete(op.id);
+      const row = rowOf(ctx, op.id);
+      if (!row) return;
+      doc.querySelectorAll('[data-parent-id="' + op.id + '"], .entity-v3-mini-card[data-agent-id="' + op.id + '"]')
+        .forEach(el => el.remove());
+      row.remove();
+    } else if (op.type === 'join') {
+      const a = JSON.parse(JSON.stringify(op.agent));
+      ctx.agents.set(a.id, a);
+      if (ctx.variant === 'v2.1') {
+        doc.querySelector('.widget-type-AGENT_STATUS tbody').insertAdjacentHTML('beforeend', widgetRowHtml(a));
+      } else {
+        doc.querySelector('.dt-table').insertAdjacentHTML('beforeend', reportRowHtml(a));
+        doc.querySelector('.popover-host').insertAdjacentHTML('beforeend', miniCardHtml(a));
+      }
+    }
+  });
+}
+
+module.exports = {
+  makeRoster,
+  makeReplay,
+  renderReport,
+  renderWidget,
+  createReplayContext,
+  applyStep
+};
@@ -0,0 +1,1039 @@
+'use strict';
+
+// DOM minimal de repli quand jsdom n'est pas installé (poste hors ligne, CI sans npm).
+//
+// Couvre uniquement ce que les deux scripts et fixtures.js utilisent : arbre + parseur
+// HTML simple, sélecteurs CSS (type, #id, .classe, [attr], [attr=|*=|^=|$=|~=],
+// :not(), combinateurs descendant/enfant, listes), MutationObserver (childList,
+// attributes, characterData, subtree), événements à bulle, localStorage, style.
+// Pas de layout : toutes les géométries valent 0. Comme jsdom, pas d'innerText.
+//
+// API exposée : new MiniDOM(html, { url }) → { window } ; window.eval(source) exécute
+// le script dans le contexte de la fenêtre (vm), window.close() coupe les timers.
+
+const vm = require('vm');
+
+const VOID_TAGS = new Set(['area', 'base', 'br', 'col', 'embed', 'hr', 'img', 'input', 'link', 'meta', 'source', 'track', 'wbr']);
+const RAW_TAGS = new Set(['script', 'style', 'textarea', 'title']);
+const ENTITIES = { amp: '&', lt: '<', gt: '>', quot: '"', apos: "'", nbsp: '\u00a0' };
+
+const ELEMENT_NODE = 1;
+const TEXT_NODE = 3;
+const COMMENT_NODE = 8;
+const DOCUMENT_NODE = 9;
+const FRAGMENT_NODE = 11;
+
+const decode = s => s.replace(/&(#x[0-9a-f]+|#\d+|[a-z]+);/gi, (m, e) => {
+  if (e[0] === '#') return String.fromCodePoint(e[1] === 'x' || e[1] === 'X' ? parseInt(e.slice(2), 16) : parseInt(e.slice(1), 10));
+  return ENTITIES[e.toLowerCase()] != null ? ENTITIES[e.toLowerCase()] : m;
+});
+const escText = s => s.replace(/&/g, '&amp;').replace(/</g, '&lt;').replace(/>/g, '&gt;').replace(/\u00a0/g, '&nbsp;');
+const escAttr = s => s.replace(/&/g, '&amp;').replace(/"/g, '&quot;').replace(/\u00a0/g, '&nbsp;');
+const kebab = s => s.replace(/[A-Z]/g, c => '-' + c.toLowerCase());
+const camel = s => s.replace(/-([a-z])/g, (m, c) => c.toUpperCase());
+
+// ===================== ÉVÉNEMENTS =====================
+class Event {
+  constructor(type, init) {
+    init = init || {};
+    this.type = type;
+    this.bubbles = !!init.bubbles;
+    this.cancelable = !!init.cancelable;
+    this.target = null;
+    this.currentTarget = null;
+    this.defaultPrevented = false;
+    this.timeStamp = Date.now();
+    this._stop = false;
+    this._stopNow = false;
+  }
+  preventDefault() { if (this.cancelable) this.defaultPrevented = true; }
+  stopPropagation() { this._stop = true; }
+  stopImmediatePropagation() { this._stop = true; this._stopNow = true; }
+}
+
+class CustomEvent extends Event {
+  constructor(type, init) { super(type, init); this.detail = init && init.detail != null ? init.detail : null; }
+}
+
+class MouseEvent extends Event {
+  constructor(type, init) {
+    super(type, init);
+    init = init || {};
+    ['clientX', 'clientY', 'screenX', 'screenY', 'button', 'buttons'].forEach(k => { this[k] = init[k] || 0; });
+    this.relatedTarget = init.relatedTarget || null;
+  }
+}
+
+class KeyboardEvent extends Event {
+  constructor(type, init) {
+    super(type, init);
+    init = init || {};
+    this.key = init.key || '';
+    this.code = init.code || '';
+    ['ctrlKey', 'shiftKey', 'altKey', 'metaKey'].forEach(k => { this[k] = !!init[k]; });
+  }
+}
+
+class EventTarget {
+  addEventListener(type, fn, opts) {
+    if (!fn) return;
+    const map = this._listeners || (this._listeners = new Map());
+    const list = map.get(type) || [];
+    if (list.some(l => l.fn === fn)) return;
+    list.push({ fn, once: !!(opts && typeof opts === 'object' && opts.once) });
+    map.set(type, list);
+  }
+  removeEventListener(type, fn) {
+    const list = this._listeners && this._listeners.get(type);
+    if (!list) return;
+    const i = list.findIndex(l => l.fn === fn);
+    if (i >= 0) list.splice(i, 1);
+  }
+  _fire(ev) {
+    const list = this._listeners && this._listeners.get(ev.type);
+    if (!list) return;
+    ev.currentTarget = this;
+    for (const l of list.slice()) {
+      if (l.once) this.removeEventListener(ev.type, l.fn);
+      const fn = typeof l.fn === 'function' ? l.fn : l.fn.handleEvent.bind(l.fn);
+      try { fn.call(this, ev); } catch (e) { reportError(this, e); }
+      if (ev._stopNow) break;
+    }
+  }
+  dispatchEvent(ev) {
+    ev.target = this;
+    const path = [];
+    for (let n = this; n; n = n._parentForEvents()) path.push(n);
+    for (const n of path) {
+      n._fire(ev);
+      if (ev._stop || !ev.bubbles) break;
+    }
+    return !ev.defaultPrevented;
+  }
+  _parentForEvents() { return null; }
+}
+
+function reportError(node, e) {
+  const win = node && (node.defaultView || (node.ownerDocument && node.ownerDocument.defaultView) || node);
+  if (win && win.console && win.console.error) win.console.error(e);
+}
+
+// ===================== MUTATIONOBSERVER =====================
+class MutationRecord {
+  constructor(type, target, init) {
+    this.type = type;
+    this.target = target;
+    this.addedNodes = init.addedNodes || [];
+    this.removedNodes = init.removedNodes || [];
+    this.previousSibling = init.previousSibling || null;
+    this.nextSibling = init.nextSibling || null;
+    this.attributeName = init.attributeName || null;
+    this.oldValue = init.oldValue != null ? init.oldValue : null;
+  }
+}
+
+function makeMutationObserver(doc) {
+  return class MutationObserver {
+    constructor(callback) {
+      this._callback = callback;
+      this._records = [];
+      this._scheduled = false;
+    }
+    observe(target, options) {
+      const o = Object.assign({}, options);
+      if (o.attributeFilter || o.attributeOldValue) o.attributes = true;
+      if (o.characterDataOldValue) o.characterData = true;
+      const regs = doc._observers;
+      const existing = regs.find(r => r.observer === this && r.target === target);
+      if (existing) existing.options = o;
+      else regs.push({ observer: this, target, options: o });
+    }
+    disconnect() {
+      doc._observers = doc._observers.filter(r => r.observer !== this);
+      this._records = [];
+    }
+    takeRecords() {
+      const out = this._records;
+      this._records = [];
+      return out;
+    }
+    _enqueue(rec) {
+      this._records.push(rec);
+      if (this._scheduled) return;
+      this._scheduled = true;
+      queueMicrotask(() => {
+        this._scheduled = false;
+        const recs = this.takeRecords();
+        if (!recs.length) return;
+        try { this._callback(recs, this); } catch (e) { reportError(doc, e); }
+      });
+    }
+  };
+}
+
+function queueMutation(target, type, init) {
+  const doc = target.nodeType === DOCUMENT_NODE ? target : target.ownerDocument;
+  if (!doc || !doc._observers.length) return;
+  const seen = new Set();
+  for (const reg of doc._observers) {
+    if (seen.has(reg.observer)) continue;
+    const o = reg.options;
+    if (type === 'childList' && !o.childList) continue;
+    if (type === 'attributes' && (!o.attributes || (o.attributeFilter && !o.attributeFilter.includes(init.attributeName)))) continue;
+    if (type === 'characterData' && !o.characterData) continue;
+    let hit = false;
+    for (let n = target; n; n = n.parentNode) {
+      if (n === reg.target) { hit = n === target || !!o.subtree; break; }
+    }
+    if (!hit) continue;
+    seen.add(reg.observer);
+    const wantOld = (type === 'attributes' && o.attributeOldValue) || (type === 'characterData' && o.characterDataOldValue);
+    reg.observer._enqueue(new MutationRecord(type, target, wantOld ? init : Object.assign({}, init, { oldValue: null })));
+  }
+}
+
+// ===================== NŒUDS =====================
+class Node extends EventTarget {
+  constructor(doc, type) {
+    super();
+    this.ownerDocument = doc;
+    this.nodeType = type;
+    this.parentNode = null;
+    this.childNodes = [];
+  }
+  get parentElement() { return this.parentNode && this.parentNode.nodeType === ELEMENT_NODE ? this.parentNode : null; }
+  get firstChild() { return this.childNodes[0] || null; }
+  get lastChild() { return this.childNodes[this.childNodes.length - 1] || null; }
+  get nextSibling() { return this._sibling(1, false); }
+  get previousSibling() { return this._sibling(-1, false); }
+  get nextElementSibling() { return this._sibling(1, true); }
+  get previousElementSibling() { return this._sibling(-1, true); }
+  _sibling(dir, elementsOnly) {
+    const p = this.parentNode;
+    if (!p) return null;
+    const sibs = p.childNodes;
+    for (let i = sibs.indexOf(this) + dir; i >= 0 && i < sibs.length; i += dir) {
+      if (!elementsOnly || sibs[i].nodeType === ELEMENT_NODE) return sibs[i];
+    }
+    return null;
+  }
+  get isConnected() {
+    let n = this;
+    while (n.parentNode) n = n.parentNode;
+    return n.nodeType === DOCUMENT_NODE;
+  }
+  _parentForEvents() { return this.parentNode; }
+  hasChildNodes() { return this.childNodes.length > 0; }
+  contains(other) {
+    for (let n = other; n; n = n.parentNode) if (n === this) return true;
+    return false;
+  }
+
+  get textContent() {
+    if (this.nodeType === TEXT_NODE || this.nodeType === COMMENT_NODE) return this._data;
+    let out = '';
+    const walk = n => n.childNodes.forEach(c => {
+      if (c.nodeType === TEXT_NODE) out += c._data;
+      else if (c.nodeType === ELEMENT_NODE) walk(c);
+    });
+    walk(this);
+    return out;
+  }
+  set textContent(v) {
+    v = v == null ? '' : String(v);
+    if (this.nodeType === TEXT_NODE || this.nodeType === COMMENT_NODE) { this.data = v; return; }
+    const removed = this._detachAll();
+    const added = [];
+    if (v) {
+      const t = this.ownerDocument.createTextNode(v);
+      this._insertRaw(t, this.childNodes.length);
+      added.push(t);
+    }
+    if (removed.length || added.length) queueMutation(this, 'childList', { addedNodes: added, removedNodes: removed });
+  }
+
+  // --- insertion/suppression ---
+  _detachAll() {
+    const removed = this.childNodes;
+    removed.forEach(c => { c.parentNode = null; });
+    this.childNodes = [];
+    return removed;
+  }
+  _insertRaw(node, index) {
+    node.parentNode = this;
+    this.childNodes.splice(index, 0, node);
+  }
+  insertBefore(node, ref) {
+    const nodes = node.nodeType === FRAGMENT_NODE ? node._detachAll() : [node];
+    if (node.nodeType === FRAGMENT_NODE && nodes.length) queueMutation(node, 'childList', { removedNodes: nodes });
+    nodes.forEach(n => { if (n.parentNode) n.parentNode.removeChild(n); });
+    let index = ref ? this.childNodes.indexOf(ref) : this.childNodes.length;
+    if (index < 0) throw new Error('NotFoundError: noeud de référence absent');
+    const prev = this.childNodes[index - 1] || null;
+    nodes.forEach(n => { n._adopt(this.ownerDocument || this); this._insertRaw(n, index++); });
+    if (nodes.length) queueMutation(this, 'childList', { addedNodes: nodes, previousSibling: prev, nextSibling: ref || null });
+    return node;
+  }
+  appendChild(node) { return this.insertBefore(node, null); }
+  removeChild(node) {
+    const i = this.childNodes.indexOf(node);
+    if (i < 0) throw new Error('NotFoundError: pas un enfant');
+    const prev = this.childNodes[i - 1] || null;
+    const next = this.childNodes[i + 1] || null;
+    this.childNodes.splice(i, 1);
+    node.parentNode = null;
+    queueMutation(this, 'childList', { removedNodes: [node], previousSibling: prev, nextSibling: next });
+    return node;
+  }
+  replaceChild(node, old) {
+    this.insertBefore(node, old);
+    return this.removeChild(old);
+  }
+  remove() { if (this.parentNode) this.parentNode.removeChild(this); }
+  replaceWith(...nodes) {
+    const p = this.parentNode;
+    if (!p) return;
+    nodes.forEach(n => p.insertBefore(typeof n === 'string' ? this.ownerDocument.createTextNode(n) : n, this));
+    p.removeChild(this);
+  }
+  before(...nodes) {
+    const p = this.parentNode;
+    if (p) nodes.forEach(n => p.insertBefore(typeof n === 'string' ? this.ownerDocument.createTextNode(n) : n, this));
+  }
+  after(...nodes) {
+    const p = this.parentNode;
+    if (!p) return;
+    const ref = this.nextSibling;
+    nodes.forEach(n => p.insertBefore(typeof n === 'string' ? this.ownerDocument.createTextNode(n) : n, ref));
+  }
+  append(...nodes) {
+    nodes.forEach(n => this.appendChild(typeof n === 'string' ? (this.ownerDocument || this).createTextNode(n) : n));
+  }
+  prepend(...nodes) {
+    const ref = this.firstChild;
+    nodes.forEach(n => this.insertBefore(typeof n === 'string' ? (this.ownerDocument || this).createTextNode(n) : n, ref));
+  }
+  _adopt(doc) {
+    if (this.ownerDocument === doc) return;
+    this.ownerDocument = doc;
+    this.childNodes.forEach(c => c._adopt(doc));
+    if (this.content) this.content._adopt(doc);
+  }
+
+  // --- requêtes ---
+  get children() { return this.childNodes.filter(c => c.nodeType === ELEMENT_NODE); }
+  get childElementCount() { return this.children.length; }
+  get firstElementChild() { return this.childNodes.find(c => c.nodeType === ELEMENT_NODE) || null; }
+  get lastElementChild() {
+    for (let i = this.childNodes.length - 1; i >= 0; i--) if (this.childNodes[i].nodeType === ELEMENT_NODE) return this.childNodes[i];
+    return null;
+  }
+  _walk(fn) {
+    const stack = this.childNodes.slice().reverse();
+    while (stack.length) {
+      const n = stack.pop();
+      if (n.nodeType !== ELEMENT_NODE) continue;
+      if (fn(n) === false) return;
+      for (let i = n.childNodes.length - 1; i >= 0; i--) stack.push(n.childNodes[i]);
+    }
+  }
+  querySelectorAll(sel) {
+    const list = parseSelector(sel);
+    const out = [];
+    this._walk(el => { if (matchesList(el, list, this)) out.push(el); });
+    return out;
+  }
+  querySelector(sel) {
+    const list = parseSelector(sel);
+    let found = null;
+    this._walk(el => {
+      if (matchesList(el, list, this)) { found = el; return false; }
+      return true;
+    });
+    return found;
+  }
+  getElementsByTagName(tag) { return this.querySelectorAll(tag); }
+  getElementsByClassName(cls) { return this.querySelectorAll(cls.trim().split(/\s+/).map(c => '.' + c).join('')); }
+}
+
+class Text extends Node {
+  constructor(doc, data, type) {
+    super(doc, type || TEXT_NODE);
+    this._data = data;
+  }
+  get data() { return this._data; }
+  set data(v) {
+    const old = this._data;
+    this._data = String(v);
+    queueMutation(this, 'characterData', { oldValue: old });
+  }
+  get nodeValue() { return this._data; }
+  set nodeValue(v) { this.data = v; }
+  get nodeName() { return this.nodeType === TEXT_NODE ? '#text' : '#comment'; }
+  cloneNode() { return new Text(this.ownerDocument, this._data, this.nodeType); }
+}
+
+class DocumentFragment extends Node {
+  constructor(doc) { super(doc, FRAGMENT_NODE); }
+  get nodeName() { return '#document-fragment'; }
+  getElementById(id) { return this.querySelector('#' + cssEscapeId(id)); }
+  cloneNode(deep) {
+    const f = new DocumentFragment(this.ownerDocument);
+    if (deep) this.childNodes.forEach(c => f._insertRaw(c.cloneNode(true), f.childNodes.length));
+    return f;
+  }
+}
+
+// --- style inline : proxy camelCase ↔ attribut style ---
+function makeStyle(el) {
+  const target = {
+    setProperty: (k, v) => { el._styleSet(k, v); },
+    removeProperty: k => { const old = el._styleMap().get(k) || ''; el._styleSet(k, ''); return old; },
+    getPropertyValue: k => el._styleMap().get(k) || ''
+  };
+  return new Proxy(target, {
+    get(t, k) {
+      if (typeof k !== 'string') return undefined;
+      if (k in t) return t[k];
+      if (k === 'cssText') return el.getAttribute('style') || '';
+      if (k === 'length') return el._styleMap().size;
+      return el._styleMap().get(kebab(k)) || '';
+    },
+    set(t, k, v) {
+      if (k === 'cssText') el.setAttribute('style', v);
+      else el._styleSet(kebab(k), v);
+      return true;
+    }
+  });
+}
+
+function parseStyle(text) {
+  const m = new Map();
+  String(text || '').split(';').forEach(decl => {
+    const i = decl.indexOf(':');
+    if (i < 0) return;
+    const k = decl.slice(0, i).trim().toLowerCase();
+    const v = decl.slice(i + 1).trim();
+    if (k && v) m.set(k, v);
+  });
+  return m;
+}
+
+const REFLECTED = { id: 'id', title: 'title', name: 'name', type: 'type', placeholder: 'placeholder', href: 'href', src: 'src', role: 'role' };
+
+class Element extends Node {
+  constructor(doc, tag) {
+    super(doc, ELEMENT_NODE);
+    this.localName = tag.toLowerCase();
+    this.tagName = this.localName.toUpperCase();
+    this._attrs = new Map();
+    this._styleCache = null;
+    this.scrollTop = 0;
+    this.scrollLeft = 0;
+    if (this.localName === 'template') this.content = new DocumentFragment(doc);
+  }
+  get nodeName() { return this.tagName; }
+
+  // --- attributs ---
+  getAttribute(name) {
+    name = name.toLowerCase();
+    return this._attrs.has(name) ? this._attrs.get(name) : null;
+  }
+  hasAttribute(name) { return this._attrs.has(name.toLowerCase()); }
+  setAttribute(name, value) {
+    name = name.toLowerCase();
+    value = String(value);
+    const old = this.getAttribute(name);
+    this._attrs.set(name, value);
+    if (name === 'style') this._styleCache = null;
+    queueMutation(this, 'attributes', { attributeName: name, oldValue: old });
+  }
+  removeAttribute(name) {
+    name = name.toLowerCase();
+    if (!this._attrs.has(name)) return;
+    const old = this._attrs.get(name);
+    this._attrs.delete(name);
+    if (name === 'style') this._styleCache = null;
+    queueMutation(this, 'attributes', { attributeName: name, oldValue: old });
+  }
+  toggleAttribute(name, force) {
+    const on = force == null ? !this.hasAttribute(name) : !!force;
+    if (on && !this.hasAttribute(name)) this.setAttribute(name, '');
+    else if (!on) this.removeAttribute(name);
+    return on;
+  }
+  get attributes() { return [...this._attrs].map(([name, value]) => ({ name, value })); }
+  getAttributeNames() { return [...this._attrs.keys()]; }
+
+  get className() { return this.getAttribute('class') || ''; }
+  set className(v) { this.setAttribute('class', v); }
+  get classList() {
+    const el = this;
+    const list = () => el.className.split(/\s+/).filter(Boolean);
+    const write = arr => el.setAttribute('class', arr.join(' '));
+    return {
+      get length() { return list().length; },
+      item: i => list()[i] || null,
+      contains: c => list().includes(c),
+      add: (...cs) => { const l = list(); cs.forEach(c => { if (!l.includes(c)) l.push(c); }); write(l); },
+      remove: (...cs) => { if (!el.hasAttribute('class')) return; write(list().filter(c => !cs.includes(c))); },
+      toggle: (c, force) => {
+        const has = list().includes(c);
+        const on = force == null ? !has : !!force;
+        if (on && !has) write(list().concat(c));
+        else if (!on && has) write(list().filter(x => x !== c));
+        return on;
+      },
+      replace: (a, b) => {
+        const l = list();
+        const i = l.indexOf(a);
+        if (i < 0) return false;
+        l[i] = b;
+        write(l);
+        return true;
+      },
+      forEach: fn => list().forEach(fn),
+      [Symbol.iterator]: () => list()[Symbol.iterator](),
+      toString: () => el.className
+    };
+  }
+  get dataset() {
+    const el = this;
+    return new Proxy({}, {
+      get: (t, k) => typeof k === 'string' ? (el.getAttribute('data-' + kebab(k)) != null ? el.getAttribute('data-' + kebab(k)) : undefined) : undefined,
+      set: (t, k, v) => { el.setAttribute('data-' + kebab(k), v); return true; },
+      deleteProperty: (t, k) => { el.removeAttribute('data-' + kebab(k)); return true; },
+      has: (t, k) => el.hasAttribute('data-' + kebab(k)),
+      ownKeys: () => el.getAttributeNames().filter(n => n.startsWith('data-')).map(n => camel(n.slice(5))),
+      getOwnPropertyDescriptor: (t, k) => el.hasAttribute('data-' + kebab(k))
+        ? { enumerable: true, configurable: true, value: el.getAttribute('data-' + kebab(k)) }
+        : undefined
+    });
+  }
+
+  _styleMap() {
+    if (!this._styleCache) this._styleCache = parseStyle(this.getAttribute('style'));
+    return this._styleCache;
+  }
+  _styleSet(k, v) {
+    const m = new Map(this._styleMap());
+    v = v == null ? '' : String(v);
+    if (v === '') m.delete(k);
+    else m.set(k, v);
+    const css = [...m].map(([a, b]) => a + ': ' + b + ';').join(' ');
+    if (css === (this.getAttribute('style') || '')) return;
+    this.setAttribute('style', css);
+    this._styleCache = m;
+  }
+  get style() { return makeStyle(this); }
+  set style(v) { this.setAttribute('style', v); }
+
+  // --- propriétés de formulaire ---
+  get value() {
+    if (this._value !== undefined) return this._value;
+    if (this.localName === 'textarea') return this.textContent;
+    if (this.localName === 'select') {
+      const opts = this.querySelectorAll('option');
+      const sel = opts.find(o => o.hasAttribute('selected')) || opts[0];
+      return sel ? sel.value : '';
+    }
+    if (this.localName === 'option' && !this.hasAttribute('value')) return this.textContent;
+    return this.getAttribute('value') || '';
+  }
+  set value(v) {
+    this._value = String(v);
+    this.selectionStart = this.selectionEnd = this._value.length;
+  }
+  get checked() { return this._checked !== undefined ? this._checked : this.hasAttribute('checked'); }
+  set checked(v) { this._checked = !!v; }
+  get disabled() { return this.hasAttribute('disabled'); }
+  set disabled(v) { this.toggleAttribute('disabled', !!v); }
+  get hidden() { return this.hasAttribute('hidden'); }
+  set hidden(v) { this.toggleAttribute('hidden', !!v); }
+
+  // --- géométrie (pas de layout) ---
+  getBoundingClientRect() { return { x: 0, y: 0, top: 0, left: 0, right: 0, bottom: 0, width: 0, height: 0 }; }
+  getClientRects() { return []; }
+  get offsetTop() { return 0; }
+  get offsetLeft() { return 0; }
+  get offsetWidth() { return 0; }
+  get offsetHeight() { return 0; }
+  get offsetParent() { return this.parentElement; }
+  get clientWidth() { return 0; }
+  get clientHeight() { return 0; }
+  get scrollWidth() { return 0; }
+  get scrollHeight() { return 0; }
+  scrollIntoView() {}
+  scrollTo() {}
+  focus() { if (this.ownerDocument) this.ownerDocument.activeElement = this; }
+  blur() { if (this.ownerDocument && this.ownerDocument.activeElement === this) this.ownerDocument.activeElement = this.ownerDocument.body; }
+  click() { this.dispatchEvent(new MouseEvent('click', { bubbles: true, cancelable: true })); }
+  setSelectionRange(a, b) { this.selectionStart = a; this.selectionEnd = b; }
+  select() {}
+
+  // --- sélecteurs ---
+  matches(sel) { return matchesList(this, parseSelector(sel), null); }
+  closest(sel) {
+    const list = parseSelector(sel);
+    for (let n = this; n && n.nodeType === ELEMENT_NODE; n = n.parentNode) {
+      if (matchesList(n, list, null)) return n;
+    }
+    return null;
+  }
+
+  // --- HTML ---
+  get innerHTML() { return serializeChildren(this.content || this); }
+  set innerHTML(html) {
+    const host = this.content || this;
+    const frag = new DocumentFragment(this.ownerDocument);
+    parseHTML(String(html == null ? '' : html), this.ownerDocument, frag);
+    const removed = host._detachAll();
+    const added = frag._detachAll();
+    added.forEach(n => host._insertRaw(n, host.childNodes.length));
+    if (removed.length || added.length) queueMutation(host, 'childList', { addedNodes: added, removedNodes: removed });
+  }
+  get outerHTML() { return serialize(this); }
+  insertAdjacentHTML(where, html) {
+    const frag = new DocumentFragment(this.ownerDocument);
+    parseHTML(String(html), this.ownerDocument, frag);
+    this._insertAdjacent(where, frag);
+  }
+  insertAdjacentElement(where, el) { this._insertAdjacent(where, el); return el; }
+  insertAdjacentText(where, text) { this._insertAdjacent(where, this.ownerDocument.createTextNode(text)); }
+  _insertAdjacent(where, node) {
+    switch (String(where).toLowerCase()) {
+      case 'beforebegin': if (this.parentNode) this.parentNode.insertBefore(node, this); break;
+      case 'afterbegin': this.insertBefore(node, this.firstChild); break;
+      case 'beforeend': this.appendChild(node); break;
+      case 'afterend': if (this.parentNode) this.parentNode.insertBefore(node, this.nextSibling); break;
+      default: throw new Error('SyntaxError: position ' + where);
+    }
+  }
+  cloneNode(deep) {
+    const el = this.ownerDocument.createElement(this.localName);
+    this._attrs.forEach((v, k) => el._attrs.set(k, v));
+    if (deep) {
+      this.childNodes.forEach(c => el._insertRaw(c.cloneNode(true), el.childNodes.length));
+      if (this.content) el.content = this.content.cloneNode(true);
+    }
+    return el;
+  }
+}
+
+Object.keys(REFLECTED).forEach(prop => {
+  Object.defineProperty(Element.prototype, prop, {
+    get() { return this.getAttribute(REFLECTED[prop]) || ''; },
+    set(v) { this.setAttribute(REFLECTED[prop], v); },
+    configurable: true
+  });
+});
+
+class Document extends Node {
+  constructor() {
+    super(null, DOCUMENT_NODE);
+    this._observers = [];
+    this.defaultView = null;
+    this.readyState = 'complete';
+    this.hidden = false;
+    this.visibilityState = 'visible';
+    this.activeElement = null;
+    const html = this.createElement('html');
+    html.appendChild(this.createElement('head'));
+    html.appendChild(this.createElement('body'));
+    this._insertRaw(html, 0);
+  }
+  get nodeName() { return '#document'; }
+  get documentElement() { return this.childNodes.find(c => c.nodeType === ELEMENT_NODE) || null; }
+  get head() { return this.documentElement && this.documentElement.children.find(c => c.localName === 'head') || null; }
+  get body() { return this.documentElement && this.documentElement.children.find(c => c.localName === 'body') || null; }
+  get title() { const t = this.querySelector('title'); return t ? t.textContent : ''; }
+  _parentForEvents() { return this.defaultView; }
+  createElement(tag) { return new Element(this, tag); }
+  createElementNS(ns, tag) { return new Element(this, tag); }
+  createTextNode(data) { return new Text(this, String(data)); }
+  createComment(data) { return new Text(this, String(data), COMMENT_NODE); }
+  createDocumentFragment() { return new DocumentFragment(this); }
+  createEvent() { return new Event(''); }
+  getElementById(id) {
+    let found = null;
+    this._walk(el => {
+      if (el._attrs.get('id') === id) { found = el; return false; }
+      return true;
+    });
+    return found;
+  }
+  hasFocus() { return true; }
+  elementFromPoint() { return null; }
+  // Remplace le contenu par un document HTML complet (mode --snapshot)
+  _load(html) {
+    const frag = new DocumentFragment(this);
+    parseHTML(html, this, frag);
+    let root = frag.childNodes.find(n => n.nodeType === ELEMENT_NODE && n.localName === 'html');
+    if (!root) {
+      root = this.createElement('html');
+      const body = this.createElement('body');
+      frag._detachAll().forEach(n => body._insertRaw(n, body.childNodes.length));
+      root._insertRaw(body, 0);
+    }
+    if (!root.children.some(c => c.localName === 'body')) root._insertRaw(this.createElement('body'), root.childNodes.length);
+    if (!root.children.some(c => c.localName === 'head')) root._insertRaw(this.createElement('head'), 0);
+    this._detachAll();
+    this._insertRaw(root, 0);
+  }
+}
+
+// ===================== PARSEUR HTML =====================
+const ATTR_RE = /\s*([^\s"'>\/=]+)(?:\s*=\s*(?:"([^"]*)"|'([^']*)'|([^\s>]+)))?/y;
+
+function parseHTML(html, doc, root) {
+  const stack = [root];
+  const top = () => { const n = stack[stack.length - 1]; return n.content || n; };
+  let i = 0;
+  const len = html.length;
+
+  while (i < len) {
+    if (html.startsWith('<!--', i)) {
+      const end = html.indexOf('-->', i + 4);
+      const stop = end < 0 ? len : end;
+      top()._insertRaw(doc.createComment(html.slice(i + 4, stop)), top().childNodes.length);
+      i = stop + 3;
+      continue;
+    }
+    if (html.startsWith('<!', i) || html.startsWith('<?', i)) {
+      const end = html.indexOf('>', i);
+      i = end < 0 ? len : end + 1;
+      continue;
+    }
+    if (html[i] === '<' && html[i + 1] === '/') {
+      const end = html.indexOf('>', i);
+      const name = html.slice(i + 2, end < 0 ? len : end).trim().toLowerCase();
+      for (let k = stack.length - 1; k > 0; k--) {
+        if (stack[k].localName === name) { stack.length = k; break; }
+      }
+      i = end < 0 ? len : end + 1;
+      continue;
+    }
+    if (html[i] === '<' && /[a-zA-Z]/.test(html[i + 1] || '')) {
+      let j = i + 1;
+      while (j < len && !/[\s\/>]/.test(html[j])) j++;
+      const el = doc.createElement(html.slice(i + 1, j));
+      let selfClose = false;
+      for (;;) {
+        while (j < len && /\s/.test(html[j])) j++;
+        if (j >= len) break;
+        if (html[j] === '>') { j++; break; }
+        if (html[j] === '/') { selfClose = true; j++; continue; }
+        ATTR_RE.lastIndex = j;
+        const m = ATTR_RE.exec(html);
+        if (!m) { j++; continue; }
+        const name = m[1].toLowerCase();
+        const value = m[2] != null ? m[2] : m[3] != null ? m[3] : m[4] != null ? m[4] : '';
+        if (!el._attrs.has(name)) el._attrs.set(name, decode(value));
+        j = ATTR_RE.lastIndex;
+      }
+      top()._insertRaw(el, top().childNodes.length);
+      i = j;
+      if (RAW_TAGS.has(el.localName)) {
+        const close = html.toLowerCase().indexOf('</' + el.localName, i);
+        const stop = close < 0 ? len : close;
+        const text = html.slice(i, stop);
+        if (text) el._insertRaw(doc.createTextNode(el.localName === 'script' || el.localName === 'style' ? text : decode(text)), 0);
+        const end = html.indexOf('>', stop);
+        i = end < 0 ? len : end + 1;
+      } else if (!VOID_TAGS.has(el.localName) && !selfClose) {
+        stack.push(el);
+      }
+      continue;
+    }
+    let next = html.indexOf('<', i + 1);
+    if (next < 0) next = len;
+    top()._insertRaw(doc.createTextNode(decode(html.slice(i, next))), top().childNodes.length);
+    i = next;
+  }
+}
+
+function serialize(node) {
+  if (node.nodeType === TEXT_NODE) {
+    const p = node.parentNode;
+    return p && (p.localName === 'style' || p.localName === 'script') ? node._data : escText(node._data);
+  }
+  if (node.nodeType === COMMENT_NODE) return '<!--' + node._data + '-->';
+  if (node.nodeType !== ELEMENT_NODE) return serializeChildren(node);
+  let out = '<' + node.localName;
+  node._attrs.forEach((v, k) => { out += ' ' + k + '="' + escAttr(v) + '"'; });
+  out += '>';
+  if (VOID_TAGS.has(node.localName)) return out;
+  return out + serializeChildren(node.content || node) + '</' + node.localName + '>';
+}
+
+function serializeChildren(node) {
+  let out = '';
+  node.childNodes.forEach(c => { out += serialize(c); });
+  return out;
+}
+
+// ===================== SÉLECTEURS =====================
+// Liste → [complexe] ; complexe → [{ comb, compound }] lu de droite à gauche.
+const selectorCache = new Map();
+
+function cssEscapeId(id) { return String(id).replace(/([^\w-])/g, '\\$1'); }
+
+function parseSelector(sel) {
+  let list = selectorCache.get(sel);
+  if (list) return list;
+  const src = String(sel);
+  let i = 0;
+
+  const ws = () => { while (i < src.length && /\s/.test(src[i])) i++; };
+  const ident = () => {
+    let out = '';
+    while (i < src.length) {
+      const c = src[i];
+      if (c === '\\') { out += src[i + 1]; i += 2; continue; }
+      if (/[\w\-\u00a0-\uffff]/.test(c)) { out += c; i++; continue; }
+      break;
+    }
+    return out;
+  };
+
+  function parseCompound() {
+    const cp = { tag: null, id: null, classes: [], attrs: [], nots: [] };
+    let any = false;
+    for (;;) {
+      const c = src[i];
+      if (c === '*') { i++; any = true; }
+      else if (c === '#') { i++; cp.id = ident(); any = true; }
+      else if (c === '.') { i++; cp.classes.push(ident()); any = true; }
+      else if (c === '[') {
+        i++; ws();
+        const name = ident().toLowerCase(); ws();
+        let op = null;
+        let value = null;
+        if (src[i] !== ']') {
+          op = src[i] === '=' ? '=' : src.slice(i, i + 2);
+          i += op.length; ws();
+          if (src[i] === '"' || src[i] === "'") {
+            const q = src[i++];
+            const end = src.indexOf(q, i);
+            value = src.slice(i, end);
+            i = end + 1;
+          } else {
+            value = ident();
+          }
+          ws();
+          if (/[iIsS]/.test(src[i]) && src[i + 1] === ']') i++;
+        }
+        if (src[i] !== ']') throw new Error('Sélecteur non supporté : ' + src);
+        i++;
+        cp.attrs.push({ name, op, value });
+        any = true;
+      } else if (c === ':') {
+        i++;
+        const name = ident().toLowerCase();
+        if (name === 'not' && src[i] === '(') {
+          i++;
+          const depthStart = i;
+          let depth = 1;
+          while (i < src.length && depth) { if (src[i] === '(') depth++; else if (src[i] === ')') depth--; i++; }
+          cp.nots.push(parseSelector(src.slice(depthStart, i - 1)));
+        } else if (name === 'first-child' || name === 'last-child' || name === 'scope') {
+          cp.attrs.push({ pseudo: name });
+        } else {
+          throw new Error('Pseudo-classe non supportée : :' + name);
+        }
+        any = true;
+      } else if (c && /[\w\-]/.test(c) && !any) {
+        cp.tag = ident().toLowerCase();
+        any = true;
+      } else break;
+    }
+    if (!any) throw new Error('Sélecteur invalide : ' + src);
+    return cp;
+  }
+
+  list = [];
+  let complex = [];
+  let comb = null;
+  ws();
+  while (i < src.length) {
+    complex.push({ comb, compound: parseCompound() });
+    const before = i;
+    ws();
+    if (i >= src.length) break;
+    if (src[i] === ',') { list.push(complex.reverse()); complex = []; comb = null; i++; ws(); continue; }
+    if (src[i] === '>' || src[i] === '+' || src[i] === '~') { comb = src[i]; i++; ws(); continue; }
+    comb = i > before ? ' ' : null;
+    if (!comb) throw new Error('Sélecteur invalide : ' + src);
+  }
+  if (complex.length) list.push(complex.reverse());
+  selectorCache.set(sel, list);
+  return list;
+}
+
+function matchCompound(el, cp, scope) {
+  if (cp.tag && el.localName !== cp.tag) return false;
+  if (cp.id != null && el._attrs.get('id') !== cp.id) return false;
+  if (cp.classes.length) {
+    const cls = ' ' + (el._attrs.get('class') || '').replace(/\s+/g, ' ') + ' ';
+    for (const c of cp.classes) if (!cls.includes(' ' + c + ' ')) return false;
+  }
+  for (const a of cp.attrs) {
+    if (a.pseudo) {
+      if (a.pseudo === 'scope' && el !== scope) return false;
+      if (a.pseudo === 'first-child' && el.previousElementSibling) return false;
+      if (a.pseudo === 'last-child' && el.nextElementSibling) return false;
+      continue;
+    }
+    const v = a.name === 'style' && el._attrs.has('style') ? el._attrs.get('style') : el._attrs.get(a.name);
+    if (v == null) return false;
+    if (!a.op) continue;
+    const w = a.value;
+    switch (a.op) {
+      case '=': if (v !== w) return false; break;
+      case '*=': if (!w || !v.includes(w)) return false; break;
+      case '^=': if (!w || !v.startsWith(w)) return false; break;
+      case '$=': if (!w || !v.endsWith(w)) return false; break;
+      case '~=': if (!v.split(/\s+/).includes(w)) return false; break;
+      case '|=': if (v !== w && !v.startsWith(w + '-')) return false; break;
+      default: return false;
+    }
+  }
+  for (const not of cp.nots) if (matchesList(el, not, scope)) return false;
+  return true;
+}
+
+// parts[0] = composé le plus à droite ; parts[k].comb relie parts[k] à parts[k-1]
+function matchComplex(el, parts, k, scope) {
+  if (!matchCompound(el, parts[k].compound, scope)) return false;
+  if (k === parts.length - 1) return true;
+  const comb = parts[k].comb;
+  if (comb === '>') {
+    const p = el.parentElement;
+    return !!p && matchComplex(p, parts, k + 1, scope);
+  }
+  if (comb === ' ') {
+    for (let p = el.parentElement; p; p = p.parentElement) {
+      if (matchComplex(p, parts, k + 1, scope)) return true;
+    }
+    return false;
+  }
+  if (comb === '+') {
+    const s = el.previousElementSibling;
+    return !!s && matchComplex(s, parts, k + 1, scope);
+  }
+  if (comb === '~') {
+    for (let s = el.previousElementSibling; s; s = s.previousElementSibling) {
+      if (matchComplex(s, parts, k + 1, scope)) return true;
+    }
+    return false;
+  }
+  return false;
+}
+
+function matchesList(el, list, scope) {
+  for (const parts of list) if (matchComplex(el, parts, 0, scope)) return true;
+  return false;
+}
+
+// ===================== FENÊTRE =====================
+function makeStorage() {
+  const store = {};
+  const methods = {
+    getItem: k => Object.prototype.hasOwnProperty.call(store, k) ? store[k] : null,
+    setItem: (k, v) => { store[String(k)] = String(v); },
+    removeItem: k => { delete store[k]; },
+    clear: () => Object.keys(store).forEach(k => delete store[k]),
+    key: i => Object.keys(store)[i] || null
+  };
+  Object.keys(methods).forEach(k => Object.defineProperty(store, k, { value: methods[k], enumerable: false }));
+  Object.defineProperty(store, 'length', { get: () => Object.keys(store).length, enumerable: false });
+  return store;
+}
+
+class MiniDOM {
+  constructor(html, options) {
+    options = options || {};
+    const doc = new Document();
+    if (html) doc._load(String(html));
+    const url = new URL(options.url || 'about:blank');
+    const timers = new Set();
+    const host = { setTimeout, clearTimeout, setInterval, clearInterval };
+
+    const window = new EventTarget();
+    const track = (fn, clear) => (cb, ms, ...args) => {
+      const id = fn(function () {
+        if (fn === host.setTimeout) timers.delete(id);
+        if (typeof cb === 'function') {
+          try { cb.apply(window, args); } catch (e) { reportError(window, e); }
+        }
+      }, ms);
+      timers.add(id);
+      return id;
+    };
+
+    Object.assign(window, {
+      document: doc,
+      console: options.console || console,
+      location: {
+        href: url.href, hostname: url.hostname, host: url.host, origin: url.origin,
+        pathname: url.pathname, hash: url.hash, search: url.search, protocol: url.protocol,
+        reload() {}, assign() {}, replace() {}
+      },
+      navigator: { userAgent: 'minidom', language: 'fr-FR', languages: ['fr-FR'] },
+      localStorage: makeStorage(),
+      sessionStorage: makeStorage(),
+      setTimeout: track(host.setTimeout),
+      setInterval: track(host.setInterval),
+      clearTimeout: id => { timers.delete(id); host.clearTimeout(id); },
+      clearInterval: id => { timers.delete(id); host.clearInterval(id); },
+      requestAnimationFrame: cb => window.setTimeout(() => cb(performanceNow()), 16),
+      cancelAnimationFrame: id => window.clearTimeout(id),
+      queueMicrotask,
+      performance: { now: performanceNow },
+      Event, CustomEvent, MouseEvent, KeyboardEvent,
+      Node, Element, HTMLElement: Element, Text, Document, DocumentFragment,
+      MutationObserver: makeMutationObserver(doc),
+      getComputedStyle: el => {
+        const m = el && el._styleMap ? el._styleMap() : new Map();
+        const defaults = { display: 'block', visibility: 'visible', opacity: '1', position: 'static' };
+        return new Proxy({}, {
+          get: (t, k) => {
+            if (k === 'getPropertyValue') return p => m.get(p) || defaults[camel(p)] || '';
+            if (typeof k !== 'string') return undefined;
+            return m.get(kebab(k)) || defaults[k] || '';
+          }
+        });
+      },
+      matchMedia: () => ({ matches: false, addListener() {}, removeListener() {}, addEventListener() {}, removeEventListener() {} }),
+      scrollTo() {},
+      focus() {},
+      alert() {},
+      innerWidth: 1920,
+      innerHeight: 1080,
+      devicePixelRatio: 1
+    });
+    ['addEventListener', 'removeEventListener', 'dispatchEvent'].forEach(k => { window[k] = EventTarget.prototype[k].bind(window); });
+    window.window = window;
+    window.self = window;
+    window.top = window;
+    window.parent = window;
+    window.frames = window;
+    doc.defaultView = window;
+
+    vm.createContext(window);
+    window.eval = source => vm.runInContext(source, window);
+    window.close = () => {
+      timers.forEach(id => { host.clearTimeout(id); host.clearInterval(id); });
+      timers.clear();
+      doc._observers = [];
+    };
+    this.window = window;
+  }
+}
+
+const t0 = Date.now();
+function performanceNow() {
+  return typeof performance !== 'undefined' ? performance.now() : Date.now() - t0;
+}
+
+module.exports = { MiniDOM };
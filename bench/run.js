@@ -0,0 +1,444 @@
+'use strict';
+
+// Banc d'essai hors ligne du pipeline Queue Monitor (aucune instance Genesys requise).
+//
+//   cd bench && npm install && npm run bench
+//   node --expose-gc run.js [--sizes 50,200,1000] [--steps 20] [--seed 42]
+//                           [--variants v2.0,v2.1] [--snapshot page.html]
+//                           [--update-baselines] [--write-fixtures]
+//
+// Sans jsdom installé (npm hors ligne), le banc bascule sur bench/minidom.js :
+// sorties et compteurs restent valables, mais ses temps ne sont pas comparables
+// à jsdom ni à un navigateur.
+//
+// Chaque script est injecté dans un jsdom avec window.__QM_BENCH__ : il n'appelle pas
+// init() et expose ses étages (findAgents, deriveStatusKey, detectChannel, durées,
+// processAgents, updateUI). Pour chaque taille, un roster synthétique est rendu puis
+// rejoué pas à pas ; on relève temps et allocations par étage, et on compare les
+// groupes produits aux baselines (bench/baselines) et entre variantes.
+//
+// Baseline = une ligne JSON par pas : { step, sha1 } + le détail du pas 0 (groups)
+// puis seulement les agents qui changent de section (moves, null = disparu).
+// L'empreinte fait foi ; le détail sert à nommer les écarts. La 1re ligne indique
+// le moteur DOM qui l'a produite : sous un autre moteur, les écarts sont signalés
+// sans faire échouer le banc.
+
+const fs = require('fs');
+const path = require('path');
+const crypto = require('crypto');
+const { performance } = require('perf_hooks');
+const fixtures = require('./fixtures');
+
+// jsdom si installé, sinon le DOM minimal embarqué (poste hors ligne)
+let jsdom = null;
+try {
+  jsdom = require('jsdom');
+} catch (e) {
+  jsdom = null;
+}
+const { MiniDOM } = require('./minidom');
+const DOM_ENGINE = jsdom ? 'jsdom' : 'minidom';
+
+const ROOT = path.join(__dirname, '..');
+const SCRIPTS = {
+  'v2.0': 'Genesys Queue Monitor (v2.0)-2.0.user.js',
+  'v2.1': 'Genesys Queue Monitor v2.1_L.O.I.C'
+};
+const BASELINE_DIR = path.join(__dirname, 'baselines');
+const BASELINE_EXT = '.jsonl';
+const SNAPSHOT_DIR = path.join(__dirname, 'snapshots');
+const OUTPUT_FILE = path.join(ROOT, 'bench_output.txt');
+const STAGES = ['findAgents', 'deriveStatusKey', 'detectChannel', 'durations', 'processAgents', 'updateUI'];
+
+// ===================== CLI =====================
+function parseArgs(argv) {
+  const opts = {
+    sizes: [50, 200, 1000],
+    steps: 20,
+    seed: 42,
+    variants: Object.keys(SCRIPTS),
+    snapshot: null,
+    updateBaselines: false,
+    writeFixtures: false
+  };
+  for (let i = 0; i < argv.length; i++) {
+    const a = argv[i];
+    if (a === '--sizes') opts.sizes = argv[++i].split(',').map(Number);
+    else if (a === '--steps') opts.steps = parseInt(argv[++i], 10);
+    else if (a === '--seed') opts.seed = parseInt(argv[++i], 10);
+    else if (a === '--variants') opts.variants = argv[++i].split(',');
+    else if (a === '--snapshot') opts.snapshot = argv[++i];
+    else if (a === '--update-baselines') opts.updateBaselines = true;
+    else if (a === '--write-fixtures') opts.writeFixtures = true;
+    else throw new Error('Option inconnue : ' + a);
+  }
+  return opts;
+}
+
+// ===================== JSDOM =====================
+function createWindow(html) {
+  const errors = [];
+  if (!jsdom) {
+    const console = {
+      log() {}, info() {}, debug() {}, warn() {},
+      error: (...a) => errors.push(a.map(x => (x && x.stack) || String(x)).join(' '))
+    };
+    const { window } = new MiniDOM(html, { url: 'https://apps.mypurecloud.de/directory/', console });
+    window.__QM_BENCH__ = {};
+    return { window, errors };
+  }
+  const { JSDOM, VirtualConsole } = jsdom;
+  const virtualConsole = new VirtualConsole();
+  virtualConsole.on('error', (...a) => errors.push(a.join(' ')));
+  virtualConsole.on('jsdomError', e => errors.push(String(e && e.message || e)));
+
+  const dom = new JSDOM(html || '<!DOCTYPE html><html><head></head><body></body></html>', {
+    url: 'https://apps.mypurecloud.de/directory/',
+    runScripts: 'outside-only',
+    pretendToBeVisual: true, // requestAnimationFrame + document.hidden === false
+    virtualConsole
+  });
+  const { window } = dom;
+  // Absents de jsdom, utilisés par les styles du panel
+  window.matchMedia = () => ({ matches: false, addListener() {}, removeListener() {} });
+  window.__QM_BENCH__ = {};
+  return { window, errors };
+}
+
+function injectScript(window, variant) {
+  const source = fs.readFileSync(path.join(ROOT, SCRIPTS[variant]), 'utf8');
+  window.eval(source);
+  const bench = window.__QM_BENCH__;
+  if (!bench.findAgents) throw new Error(variant + ' : window.__QM_BENCH__ non renseigné par le script');
+  bench.setup();
+  return bench;
+}
+
+// MutationObserver → microtâches ; les timers éventuels du script passent aussi
+const settle = () => new Promise(resolve => setImmediate(resolve));
+
+// ===================== MESURES =====================
+function measure(samples, stage, fn) {
+  if (global.gc) global.gc();
+  const m0 = process.memoryUsage().heapUsed;
+  const t0 = performance.now();
+  const out = fn();
+  const dt = performance.now() - t0;
+  const bytes = process.memoryUsage().heapUsed - m0;
+  (samples[stage] = samples[stage] || []).push({ ms: dt, bytes: Math.max(0, bytes) });
+  return out;
+}
+
+function runStages(bench, samples) {
+  const agents = measure(samples, 'findAgents', () => bench.findAgents());
+  // Relevé du scan lui-même : processAgents relira ensuite des lignes déjà en cache
+  const stats = bench.stats();
+  measure(samples, 'deriveStatusKey', () => agents.map(a => bench.deriveStatusKey(a)));
+  if (bench.detectChannel) {
+    measure(samples, 'detectChannel', () => agents.map(a => bench.detectChannel(a.rowElement, a.status)));
+  }
+  const d = bench.durations;
+  measure(samples, 'durations', () => agents.map(a => [
+    d.status(a.rowElement),
+    d.call(a.rowElement),
+    d.taskCall(a.rowElement),
+    d.chat(a.rowElement)
+  ]));
+  measure(samples, 'processAgents', () => bench.processAgents());
+  // Compteurs du patch réel du panel (processAgents → updateUI) ; l'étage updateUI
+  // suivant repasse les mêmes groupes et les remettrait à zéro
+  const ui = bench.stats().ui;
+  measure(samples, 'updateUI', () => bench.updateUI(bench.groups()));
+  return { agents: agents.length, stats, ui };
+}
+
+// Sortie comparable : section → noms triés
+function snapshotGroups(groups) {
+  const out = {};
+  Object.keys(groups || {}).sort().forEach(k => {
+    const names = (groups[k] || []).map(a => a.name).sort();
+    if (names.length) out[k] = names;
+  });
+  return out;
+}
+
+function sectionByName(snap) {
+  const m = new Map();
+  Object.keys(snap).forEach(k => snap[k].forEach(n => { if (!m.has(n)) m.set(n, k); }));
+  return m;
+}
+
+function diffSnapshots(a, b) {
+  return diffSections(sectionByName(a), sectionByName(b));
+}
+
+function diffSections(ma, mb) {
+  const out = [];
+  new Set([...ma.keys(), ...mb.keys()]).forEach(n => {
+    const ka = ma.get(n) || '∅';
+    const kb = mb.get(n) || '∅';
+    if (ka !== kb) out.push({ name: n, from: ka, to: kb });
+  });
+  return out;
+}
+
+const pct = (xs, p) => {
+  const s = [...xs].sort((x, y) => x - y);
+  return s.length ? s[Math.min(s.length - 1, Math.floor(p * s.length))] : 0;
+};
+
+// ===================== EXÉCUTION =====================
+async function runReplay(variant, size, opts) {
+  const { window, errors } = createWindow();
+  const roster = fixtures.makeRoster(size, opts.seed);
+  const replay = fixtures.makeReplay(roster, opts.steps, opts.seed);
+  const ctx = fixtures.createReplayContext(window.document, variant, roster);
+
+  const bench = injectScript(window, variant);
+  const cold = {};
+  const warm = {};
+  const outputs = [];
+  const stats = [];
+
+  // Pas 0 : premier passage (parse complet, construction du panel)
+  await settle();
+  stats.push(runStages(bench, cold));
+  outputs.push(snapshotGroups(bench.groups()));
+
+  for (const step of replay) {
+    fixtures.applyStep(ctx, step);
+    await settle();
+    // Agents réellement modifiés (statut, arrivée) : cible du re-parse incrémental
+    const changed = step.ops.filter(op => op.type === 'status' || op.type === 'join').length;
+    stats.push(Object.assign(runStages(bench, warm), { changed }));
+    outputs.push(snapshotGroups(bench.groups()));
+  }
+
+  window.close();
+  return { variant, size, cold, warm, outputs, stats, errors };
+}
+
+async function runSnapshot(file, opts) {
+  const html = fs.readFileSync(file, 'utf8');
+  const { window, errors } = createWindow(html);
+  const variant = window.document.querySelector('.widget-type-AGENT_STATUS') ? 'v2.1' : 'v2.0';
+  const bench = injectScript(window, variant);
+  const cold = {};
+  const warm = {};
+  const outputs = [];
+  const stats = [];
+
+  await settle();
+  stats.push(runStages(bench, cold));
+  outputs.push(snapshotGroups(bench.groups()));
+  for (let i = 0; i < opts.steps; i++) {
+    await settle();
+    stats.push(runStages(bench, warm));
+    outputs.push(snapshotGroups(bench.groups()));
+  }
+
+  window.close();
+  const size = 'snapshot-' + path.basename(file, path.extname(file));
+  return { variant, size, cold, warm, outputs, stats, errors };
+}
+
+// ===================== RAPPORT =====================
+function formatRun(run, lines) {
+  lines.push('');
+  lines.push('== ' + run.variant + ' / ' + run.size + ' agents ==' +
+             (DOM_ENGINE === 'minidom' ? ' (minidom : temps indicatifs, non comparables)' : ''));
+  lines.push('étage'.padEnd(16) + 'froid ms'.padStart(10) + 'méd ms'.padStart(10) +
+             'p95 ms'.padStart(10) + 'max ms'.padStart(10) + 'alloc Ko'.padStart(11));
+  STAGES.forEach(stage => {
+    const w = run.warm[stage];
+    const c = run.cold[stage];
+    if (!w && !c) return;
+    const ms = (w || []).map(s => s.ms);
+    const kb = (w || []).reduce((acc, s) => acc + s.bytes, 0) / Math.max(1, (w || []).length) / 1024;
+    lines.push(
+      stage.padEnd(16) +
+      (c ? c[0].ms.toFixed(2) : '-').padStart(10) +
+      pct(ms, 0.5).toFixed(2).padStart(10) +
+      pct(ms, 0.95).toFixed(2).padStart(10) +
+      (ms.length ? Math.max(...ms) : 0).toFixed(2).padStart(10) +
+      kb.toFixed(1).padStart(11)
+    );
+  });
+
+  const last = run.stats[run.stats.length - 1];
+  lines.push('agents lus (dernier pas) : ' + last.agents);
+  if (last.stats && last.stats.scan) {
+    const warmStats = run.stats.slice(1);
+    const parsed = warmStats.map(s => s.stats.scan.parsed);
+    const sel = warmStats.map(s => s.stats.selectorCalls);
+    lines.push('lignes re-parsées / pas (méd) : ' + pct(parsed, 0.5) +
+               ' ; sélecteurs / pas (méd) : ' + pct(sel, 0.5));
+    if (warmStats.some(s => s.changed != null)) {
+      lines.push('re-parsées / agents modifiés par pas : ' +
+                 warmStats.map(s => s.stats.scan.parsed + '/' + s.changed).join(' '));
+    }
+  }
+  const uiRuns = run.stats.slice(1).filter(s => s.ui);
+  if (uiRuns.length) {
+    const moved = uiRuns.map(s => s.ui.cardsMoved);
+    lines.push('cartes déplacées / pas (méd, max) : ' + pct(moved, 0.5) + ', ' + Math.max(...moved) +
+               ' ; reconstruites (méd) : ' + pct(uiRuns.map(s => s.ui.cardsBuilt), 0.5));
+  }
+  if (run.errors.length) {
+    lines.push('erreurs console : ' + run.errors.length + ' (1re : ' + run.errors[0].slice(0, 160) + ')');
+  }
+}
+
+// ===================== BASELINES =====================
+const snapshotHash = snap => crypto.createHash('sha1').update(JSON.stringify(snap)).digest('hex').slice(0, 16);
+
+function encodeBaseline(run, opts) {
+  const rows = [{ engine: DOM_ENGINE, seed: opts.seed, steps: run.outputs.length }];
+  let prev = null;
+  run.outputs.forEach((snap, step) => {
+    const row = { step, sha1: snapshotHash(snap) };
+    const cur = sectionByName(snap);
+    if (!prev) {
+      row.groups = snap;
+    } else {
+      row.moves = {};
+      diffSections(prev, cur).forEach(d => { row.moves[d.name] = d.to === '∅' ? null : d.to; });
+    }
+    prev = cur;
+    rows.push(row);
+  });
+  return rows.map(r => JSON.stringify(r)).join('\n') + '\n';
+}
+
+// → { engine, steps: [{ sha1, sections: Map nom → section }] }
+function decodeBaseline(text) {
+  const [head, ...rows] = text.split('\n').filter(Boolean).map(l => JSON.parse(l));
+  let cur = new Map();
+  const steps = rows.map(r => {
+    if (r.groups) {
+      cur = sectionByName(r.groups);
+    } else {
+      cur = new Map(cur);
+      Object.keys(r.moves || {}).forEach(n => {
+        if (r.moves[n] == null) cur.delete(n);
+        else cur.set(n, r.moves[n]);
+      });
+    }
+    return { sha1: r.sha1, sections: cur };
+  });
+  return { engine: head.engine, steps };
+}
+
+function compareBaseline(run, opts, lines) {
+  const file = path.join(BASELINE_DIR, run.variant + '-' + run.size + BASELINE_EXT);
+  if (opts.updateBaselines) {
+    fs.mkdirSync(BASELINE_DIR, { recursive: true });
+    fs.writeFileSync(file, encodeBaseline(run, opts));
+    lines.push('baseline écrite : ' + path.relative(ROOT, file) + ' (' + DOM_ENGINE + ')');
+    return 0;
+  }
+  if (!fs.existsSync(file)) {
+    lines.push('pas de baseline (--update-baselines pour la créer)');
+    return 0;
+  }
+  const base = decodeBaseline(fs.readFileSync(file, 'utf8'));
+  let changed = 0;
+  run.outputs.forEach((out, i) => {
+    const b = base.steps[i];
+    if (!b || b.sha1 === snapshotHash(out)) return;
+    const d = diffSections(b.sections, sectionByName(out));
+    changed += Math.max(1, d.length);
+    lines.push('  pas ' + i + ' : ' + (d.length
+      ? d.length + ' écart(s) vs baseline — ' + d.slice(0, 5).map(x => x.name + ' ' + x.from + '→' + x.to).join(', ')
+      : 'empreinte différente de la baseline (mêmes sections, doublon ou section vide en plus)'));
+  });
+  if (!changed) {
+    lines.push('sortie identique à la baseline');
+    return 0;
+  }
+  lines.push('DIFF vs baseline : ' + changed + ' écart(s)');
+  if (base.engine !== DOM_ENGINE) {
+    lines.push('  baseline produite sous ' + base.engine + ', non vérifiée sous ' + DOM_ENGINE +
+               ' : écarts signalés sans échec (--update-baselines pour la régénérer)');
+    return 0;
+  }
+  return changed;
+}
+
+// Même roster, même rejeu : où les deux variantes classent-elles différemment ?
+function compareVariants(a, b, lines) {
+  const pairs = new Map();
+  a.outputs.forEach((out, i) => {
+    if (!b.outputs[i]) return;
+    diffSnapshots(out, b.outputs[i]).forEach(d => {
+      const k = d.from + ' → ' + d.to;
+      pairs.set(k, (pairs.get(k) || 0) + 1);
+    });
+  });
+  lines.push('');
+  lines.push('== ' + a.variant + ' vs ' + b.variant + ' / ' + a.size + ' agents (section, tous pas confondus) ==');
+  if (!pairs.size) lines.push('classement identique');
+  [...pairs.entries()].sort((x, y) => y[1] - x[1]).forEach(([k, n]) => lines.push('  ' + k.padEnd(34) + n));
+}
+
+function writeFixtures(opts) {
+  fs.mkdirSync(SNAPSHOT_DIR, { recursive: true });
+  opts.sizes.forEach(size => {
+    const roster = fixtures.makeRoster(size, opts.seed);
+    [['report', fixtures.renderReport], ['widget', fixtures.renderWidget]].forEach(([kind, render]) => {
+      const { window } = jsdom
+        ? new jsdom.JSDOM('<!DOCTYPE html><html><head></head><body></body></html>')
+        : new MiniDOM(null, {});
+      render(window.document, roster);
+      const file = path.join(SNAPSHOT_DIR, kind + '-' + size + '.html');
+      fs.writeFileSync(file, window.document.documentElement.outerHTML);
+      console.log('écrit', path.relative(ROOT, file));
+      window.close();
+    });
+  });
+}
+
+async function main() {
+  const opts = parseArgs(process.argv.slice(2));
+  if (opts.writeFixtures) {
+    writeFixtures(opts);
+    return;
+  }
+  if (!global.gc) console.warn('[bench] lancer avec --expose-gc pour des allocations fiables');
+
+  const lines = ['Queue Monitor bench — ' + new Date().toISOString() +
+                 ' (graine ' + opts.seed + ', ' + opts.steps + ' pas, ' + DOM_ENGINE + ')'];
+  if (DOM_ENGINE === 'minidom') {
+    lines.push('NB : jsdom absent, DOM minimal embarqué. Les sorties et compteurs (lignes re-parsées,',
+               '     cartes déplacées) sont valables ; les temps ne sont comparables ni à jsdom ni à');
+    lines.push('     un navigateur, seulement entre deux passes minidom sur la même machine.');
+  }
+  let diffs = 0;
+
+  if (opts.snapshot) {
+    const run = await runSnapshot(path.resolve(opts.snapshot), opts);
+    formatRun(run, lines);
+    diffs += compareBaseline(run, opts, lines);
+  } else {
+    for (const size of opts.sizes) {
+      const runs = [];
+      for (const variant of opts.variants) {
+        const run = await runReplay(variant, size, opts);
+        formatRun(run, lines);
+        diffs += compareBaseline(run, opts, lines);
+        runs.push(run);
+      }
+      if (runs.length === 2) compareVariants(runs[0], runs[1], lines);
+    }
+  }
+
+  const report = lines.join('\n') + '\n';
+  process.stdout.write(report);
+  fs.writeFileSync(OUTPUT_FILE, report);
+  if (diffs) process.exitCode = 1;
+}
+
+main().catch(e => {
+  console.error(e);
+  process.exitCode = 2;
+});